@@ -15,6 +15,14 @@ std::string Action::toString() const {
     }
 }
 
+bool Action::operator==(const Action &other) const {
+    return type == other.type && ships == other.ships && flightPlan == other.flightPlan;
+}
+
+bool Action::operator!=(const Action &other) const {
+    return !(*this == other);
+}
+
 Action Action::spawn(int ships) {
     return {ActionType::SPAWN, ships, {}};
 }
@@ -23,10 +31,14 @@ Action Action::launch(int ships, const FlightPlan &flightPlan) {
     return {ActionType::LAUNCH, ships, flightPlan};
 }
 
-Action Action::launch(int ships, const std::string &flightPlan) {
+Action Action::launch(int ships, std::string_view flightPlan) {
     return launch(ships, FlightPlan::parse(flightPlan));
 }
 
+Action Action::launch(int ships, const EncodedFlightPlan &flightPlan) {
+    return launch(ships, flightPlan.decode());
+}
+
 Action Action::parse(const std::string &action) {
     if (action[0] == 'S') {
         return spawn(std::atoi(action.substr(6).c_str()));
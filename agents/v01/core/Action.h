@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <core/FlightPlan.h>
 
@@ -18,10 +19,14 @@ struct Action {
 
     [[nodiscard]] std::string toString() const;
 
+    [[nodiscard]] bool operator==(const Action &other) const;
+    [[nodiscard]] bool operator!=(const Action &other) const;
+
     [[nodiscard]] static Action spawn(int ships);
 
     [[nodiscard]] static Action launch(int ships, const FlightPlan &flightPlan);
-    [[nodiscard]] static Action launch(int ships, const std::string &flightPlan);
+    [[nodiscard]] static Action launch(int ships, std::string_view flightPlan);
+    [[nodiscard]] static Action launch(int ships, const EncodedFlightPlan &flightPlan);
 
     [[nodiscard]] static Action parse(const std::string &action);
 };
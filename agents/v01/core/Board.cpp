@@ -1,271 +1,590 @@
 #include <algorithm>
-#include <cmath>
-#include <memory>
-#include <unordered_map>
+#include <memory_resource>
 #include <utility>
+#include <vector>
 
 #include <core/Action.h>
 #include <core/Board.h>
-#include <core/Shipyard.h>
-#include <core/Fleet.h>
 
-int Board::COPY_CALLS = 0;
-int Board::NEXT_CALLS = 0;
-
-Board::Board(const Configuration &config)
-        : _idCounter(1),
-          config(config),
+std::atomic<int> Board::COPY_CALLS = 0;
+std::atomic<int> Board::FORK_CALLS = 0;
+std::atomic<int> Board::NEXT_CALLS = 0;
+
+std::atomic<int> Board::NEXT_GENERATION = 0;
+
+Board::Board(std::shared_ptr<const GameContext> context, std::pmr::memory_resource *resource)
+        : _context(std::move(context)),
+          _idCounter(1),
+          _generation(NEXT_GENERATION.fetch_add(1, std::memory_order_relaxed)),
+          _hasRemovedEntities(false),
+          _parent(nullptr),
+          _recordUndo(false),
+          _undoLog(),
+          _occupiedCells(resource),
           step(),
-          cells(config.size),
-          players(),
+          cells(_context->config(), resource),
+          players(resource),
+          shipyards(resource),
+          fleets(resource),
           meIndex(),
-          remainingOverageTime(),
-          shipyardsById(),
-          fleetsById() {}
+          remainingOverageTime() {}
+
+Board::Board(const Board &other) : Board(other, other.resource()) {}
+
+Board::Board(const Board &other, std::pmr::memory_resource *resource)
+        : _context(other._context),
+          _idCounter(other._idCounter),
+          _generation(other._generation),
+          _hasRemovedEntities(other._hasRemovedEntities),
+          _parent(other._parent),
+          _recordUndo(other._recordUndo),
+          _undoLog(),
+          _occupiedCells(other._occupiedCells, resource),
+          step(other.step),
+          cells(other.cells, resource),
+          players(other.players, resource),
+          shipyards(other.shipyards, resource),
+          fleets(other.fleets, resource),
+          meIndex(other.meIndex),
+          remainingOverageTime(other.remainingOverageTime) {}
+
+const GameContext &Board::context() const {
+    return *_context;
+}
+
+const Configuration &Board::config() const {
+    return _context->config();
+}
+
+const Topology &Board::topology() const {
+    return cells.topology();
+}
 
 Player &Board::me() {
-    return *players[meIndex];
+    return players[meIndex];
 }
 
 const Player &Board::me() const {
-    return *players[meIndex];
+    return players[meIndex];
 }
 
 Player &Board::opponent() {
-    return *players[meIndex == 0 ? 1 : 0];
+    return players[meIndex == 0 ? 1 : 0];
 }
 
 const Player &Board::opponent() const {
-    return *players[meIndex == 0 ? 1 : 0];
+    return players[meIndex == 0 ? 1 : 0];
 }
 
-Board Board::copy() const {
-    COPY_CALLS++;
+PlayerEntities<std::pmr::vector<Shipyard>> Board::shipyardsOf(int player) {
+    return {shipyards, player};
+}
+
+PlayerEntities<const std::pmr::vector<Shipyard>> Board::shipyardsOf(int player) const {
+    return {shipyards, player};
+}
+
+PlayerEntities<std::pmr::vector<Fleet>> Board::fleetsOf(int player) {
+    return {fleets, player};
+}
+
+PlayerEntities<const std::pmr::vector<Fleet>> Board::fleetsOf(int player) const {
+    return {fleets, player};
+}
 
-    Board newBoard(config);
+Shipyard *Board::shipyardAt(const Cell &cell) {
+    return cell.shipyard == -1 ? nullptr : &shipyards[cell.shipyard];
+}
 
-    newBoard.step = step;
-    newBoard.meIndex = meIndex;
-    newBoard.remainingOverageTime = remainingOverageTime;
+const Shipyard *Board::shipyardAt(const Cell &cell) const {
+    return cell.shipyard == -1 ? nullptr : &shipyards[cell.shipyard];
+}
 
-    for (int i = 0, iMax = config.size * config.size; i < iMax; i++) {
-        newBoard.cells.at(i).kore = cells.at(i).kore;
+CellFleets Board::fleetsAt(const Cell &cell) const {
+    return {fleets.data(), cell};
+}
+
+Shipyard *Board::findShipyard(EntityId id) {
+    for (auto &shipyard : shipyards) {
+        if (shipyard.id == id) {
+            return &shipyard;
+        }
     }
 
-    newBoard.players.reserve(players.size());
-    for (const auto &player : players) {
-        auto newPlayer = std::make_unique<Player>();
-        newPlayer->id = player->id;
-        newPlayer->kore = player->kore;
-
-        newPlayer->shipyards.reserve(player->shipyards.size());
-        for (const auto &shipyard : player->shipyards) {
-            auto newShipyard = std::make_unique<Shipyard>();
-            newShipyard->id = shipyard->id;
-            newShipyard->cell = &newBoard.cells.at(shipyard->cell->x, shipyard->cell->y);
-            newShipyard->player = newPlayer.get();
-            newShipyard->ships = shipyard->ships;
-            newShipyard->turnsControlled = shipyard->turnsControlled;
-            newShipyard->action = shipyard->action;
-
-            newBoard.shipyardsById[newShipyard->id] = newShipyard.get();
-
-            newShipyard->cell->shipyard = newShipyard.get();
-            newPlayer->shipyards.push_back(std::move(newShipyard));
+    return nullptr;
+}
+
+const Shipyard *Board::findShipyard(EntityId id) const {
+    for (const auto &shipyard : shipyards) {
+        if (shipyard.id == id) {
+            return &shipyard;
         }
+    }
 
-        newPlayer->fleets.reserve(player->fleets.size());
-        for (const auto &fleet : player->fleets) {
-            auto newFleet = std::make_unique<Fleet>();
-            newFleet->id = fleet->id;
-            newFleet->cell = &newBoard.cells.at(fleet->cell->x, fleet->cell->y);
-            newFleet->player = newPlayer.get();
-            newFleet->kore = fleet->kore;
-            newFleet->ships = fleet->ships;
-            newFleet->direction = fleet->direction;
-            newFleet->flightPlan = FlightPlan(fleet->flightPlan);
-
-            newBoard.fleetsById[newFleet->id] = newFleet.get();
-
-            newFleet->cell->fleets.push_back(newFleet.get());
-            newPlayer->fleets.push_back(std::move(newFleet));
+    return nullptr;
+}
+
+Fleet *Board::findFleet(EntityId id) {
+    for (auto &fleet : fleets) {
+        if (fleet.id == id) {
+            return &fleet;
         }
+    }
 
-        newBoard.players.push_back(std::move(newPlayer));
+    return nullptr;
+}
+
+const Fleet *Board::findFleet(EntityId id) const {
+    for (const auto &fleet : fleets) {
+        if (fleet.id == id) {
+            return &fleet;
+        }
     }
 
+    return nullptr;
+}
+
+int Board::getShipCount(int player) const {
+    int ships = 0;
+
+    for (const auto &shipyard : shipyardsOf(player)) {
+        ships += shipyard.ships;
+    }
+
+    for (const auto &fleet : fleetsOf(player)) {
+        ships += fleet.ships;
+    }
+
+    return ships;
+}
+
+EntityHandle Board::handleOf(const Shipyard &shipyard) const {
+    return {static_cast<int>(&shipyard - shipyards.data()), _generation};
+}
+
+EntityHandle Board::handleOf(const Fleet &fleet) const {
+    return {static_cast<int>(&fleet - fleets.data()), _generation};
+}
+
+Shipyard *Board::getShipyard(EntityHandle handle) {
+    if (handle.generation != _generation || handle.index >= static_cast<int>(shipyards.size())
+        || shipyards[handle.index].player == REMOVED) {
+        return nullptr;
+    }
+
+    return &shipyards[handle.index];
+}
+
+Fleet *Board::getFleet(EntityHandle handle) {
+    if (handle.generation != _generation || handle.index >= static_cast<int>(fleets.size())
+        || fleets[handle.index].player == REMOVED) {
+        return nullptr;
+    }
+
+    return &fleets[handle.index];
+}
+
+Shipyard &Board::addShipyard(Shipyard shipyard) {
+    startGeneration();
+
+    cells.at(shipyard.cell).shipyard = shipyards.size();
+    return shipyards.emplace_back(std::move(shipyard));
+}
+
+Fleet &Board::addFleet(Fleet fleet) {
+    fleet.trajectory = Trajectory(fleet.cell, fleet.direction, fleet.flightPlan, config().size);
+
+    startGeneration();
+
+    fleets.emplace_back(std::move(fleet));
+    linkFleet(fleets.size() - 1);
+
+    return fleets.back();
+}
+
+std::pmr::memory_resource *Board::resource() const {
+    return fleets.get_allocator().resource();
+}
+
+Board Board::copy() const {
+    return copy(resource());
+}
+
+Board Board::copy(std::pmr::memory_resource *resource) const {
+    COPY_CALLS.fetch_add(1, std::memory_order_relaxed);
+
+    // All state is stored by value and linked by index, so the copy needs no pointer fix-ups
+    Board newBoard(*this, resource);
+    newBoard._parent = nullptr;
+    newBoard.cells.detach();
+
+    return newBoard;
+}
+
+Board Board::fork() {
+    return fork(resource());
+}
+
+Board Board::fork(std::pmr::memory_resource *resource) {
+    FORK_CALLS.fetch_add(1, std::memory_order_relaxed);
+
+    Board newBoard(*this, resource);
+    newBoard._parent = this;
+
     return newBoard;
 }
 
+void Board::commit() {
+    Board *grandparent = _parent->_parent;
+
+    // The kore snapshots of the turns this board recorded live in its resource, so only a parent allocating from
+    // the same resource can keep them
+    std::vector<UndoEntry> undoLog;
+    if (_parent->resource() == resource()) {
+        undoLog = std::move(_parent->_undoLog);
+        undoLog.insert(undoLog.end(), _undoLog.begin(), _undoLog.end());
+    }
+
+    *_parent = *this;
+    _parent->_parent = grandparent;
+    _parent->_undoLog = std::move(undoLog);
+
+    if (_parent->resource() != resource()) {
+        _parent->cells.detach();
+    }
+}
+
+void Board::discard() {
+    Board *parent = _parent;
+
+    *this = *parent;
+    _parent = parent;
+    _undoLog.clear();
+}
+
+void Board::setRecordUndo(bool recordUndo) {
+    _recordUndo = recordUndo;
+
+    if (!recordUndo) {
+        _undoLog.clear();
+    }
+}
+
+bool Board::canUndo() const {
+    return !_undoLog.empty();
+}
+
+void Board::undo() {
+    auto &entry = _undoLog.back();
+
+    for (const auto &fleet : fleets) {
+        auto &cell = cells.at(fleet.cell);
+        cell.firstFleet = -1;
+        cell.lastFleet = -1;
+    }
+
+    for (const auto &shipyard : shipyards) {
+        cells.at(shipyard.cell).shipyard = -1;
+    }
+
+    step = entry.step;
+    _idCounter = entry.idCounter;
+
+    // Handles taken after the entry was recorded may point past the restored entities or at other ones
+    startGeneration();
+
+    players.assign(entry.players.begin(), entry.players.end());
+    shipyards.assign(entry.shipyards.begin(), entry.shipyards.end());
+    fleets.assign(entry.fleets.begin(), entry.fleets.end());
+
+    cells.restoreKore(entry.kore);
+
+    // The restored fleets carry their links, only the ends of each list are stored in the cells
+    for (int i = 0, iMax = fleets.size(); i < iMax; i++) {
+        auto &cell = cells.at(fleets[i].cell);
+
+        if (fleets[i].previousInCell == -1) {
+            cell.firstFleet = i;
+        }
+
+        if (fleets[i].nextInCell == -1) {
+            cell.lastFleet = i;
+        }
+    }
+
+    linkShipyards();
+
+    _undoLog.pop_back();
+}
+
 void Board::next() {
-    NEXT_CALLS++;
+    if (config().size == 21) {
+        nextSized<21>();
+    } else {
+        nextSized<CellMap::DYNAMIC_SIZE>();
+    }
+}
+
+template<int Size>
+void Board::nextSized() {
+    NEXT_CALLS.fetch_add(1, std::memory_order_relaxed);
+
+    if (_recordUndo) {
+        recordUndoEntry();
+    }
 
     _idCounter = 1;
 
     turnResolutionSpawningAndLaunching();
-    turnResolutionFleetsUpdate();
+    turnResolutionFleetsUpdate<Size>();
     turnResolutionAlliedFleetsCoalesce();
     turnResolutionFleetCollisions();
     turnResolutionShipyardCollision();
-    turnResolutionFleetToFleetDamage();
+    turnResolutionFleetToFleetDamage<Size>();
     turnResolutionKoreMining();
     turnResolutionKoreRegeneration();
     turnResolutionEndTurn();
 }
 
+void Board::startGeneration() {
+    _generation = NEXT_GENERATION.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Board::linkShipyards() {
+    for (int i = 0, iMax = shipyards.size(); i < iMax; i++) {
+        cells.at(shipyards[i].cell).shipyard = i;
+    }
+}
+
+void Board::recordUndoEntry() {
+    auto &entry = _undoLog.emplace_back();
+
+    entry.step = step;
+    entry.idCounter = _idCounter;
+
+    entry.players.assign(players.begin(), players.end());
+    entry.shipyards.assign(shipyards.begin(), shipyards.end());
+    entry.fleets.assign(fleets.begin(), fleets.end());
+
+    // The snapshot shares the kore buffer, which is only copied once the next turn writes to it
+    entry.kore = cells.saveKore();
+}
+
+void Board::removeShipyard(int index) {
+    cells.at(shipyards[index].cell).shipyard = -1;
+    shipyards[index].player = REMOVED;
+
+    _hasRemovedEntities = true;
+}
+
+void Board::removeFleet(int index) {
+    unlinkFleet(index);
+    fleets[index].player = REMOVED;
+
+    _hasRemovedEntities = true;
+}
+
+void Board::linkFleet(int index) {
+    auto &fleet = fleets[index];
+    auto &cell = cells.at(fleet.cell);
+
+    fleet.previousInCell = cell.lastFleet;
+    fleet.nextInCell = -1;
+
+    if (cell.lastFleet == -1) {
+        cell.firstFleet = index;
+    } else {
+        fleets[cell.lastFleet].nextInCell = index;
+    }
+
+    cell.lastFleet = index;
+}
+
+void Board::unlinkFleet(int index) {
+    auto &fleet = fleets[index];
+    auto &cell = cells.at(fleet.cell);
+
+    if (fleet.previousInCell != -1) {
+        fleets[fleet.previousInCell].nextInCell = fleet.nextInCell;
+    } else if (cell.firstFleet == index) {
+        cell.firstFleet = fleet.nextInCell;
+    } else {
+        // Fleets launched this turn are not in a cell until they first move
+        return;
+    }
+
+    if (fleet.nextInCell != -1) {
+        fleets[fleet.nextInCell].previousInCell = fleet.previousInCell;
+    } else {
+        cell.lastFleet = fleet.previousInCell;
+    }
+
+    fleet.previousInCell = -1;
+    fleet.nextInCell = -1;
+}
+
+void Board::compactEntities() {
+    // Compaction keeps the order of the remaining entities, which decides the order the turn phases process them in
+    thread_local std::vector<int> newFleetIndices;
+    newFleetIndices.resize(fleets.size());
+
+    int fleetCount = 0;
+    for (int i = 0, iMax = fleets.size(); i < iMax; i++) {
+        if (fleets[i].player != REMOVED) {
+            newFleetIndices[i] = fleetCount;
+            fleets[fleetCount++] = fleets[i];
+        }
+    }
+
+    fleets.resize(fleetCount);
+
+    for (int i = 0; i < fleetCount; i++) {
+        auto &fleet = fleets[i];
+        auto &cell = cells.at(fleet.cell);
+
+        if (fleet.previousInCell == -1) {
+            cell.firstFleet = i;
+        } else {
+            fleet.previousInCell = newFleetIndices[fleet.previousInCell];
+        }
+
+        if (fleet.nextInCell == -1) {
+            cell.lastFleet = i;
+        } else {
+            fleet.nextInCell = newFleetIndices[fleet.nextInCell];
+        }
+    }
+
+    shipyards.erase(std::remove_if(shipyards.begin(), shipyards.end(), [](const Shipyard &shipyard) {
+        return shipyard.player == REMOVED;
+    }), shipyards.end());
+
+    linkShipyards();
+
+    startGeneration();
+    _hasRemovedEntities = false;
+}
+
 void Board::turnResolutionSpawningAndLaunching() {
     for (auto &player : players) {
-        for (const auto &shipyard : player->shipyards) {
-            if (!shipyard->action.has_value()) {
+        for (auto &shipyard : shipyardsOf(player.id)) {
+            if (!shipyard.action.has_value()) {
                 continue;
             }
 
-            int ships = shipyard->action->ships;
+            int ships = shipyard.action->ships;
             if (ships == 0) {
                 continue;
             }
 
-            if (shipyard->action->type == ActionType::SPAWN) {
-                double spawnCost = config.spawnCost * shipyard->action->ships;
-                if (spawnCost > player->kore || ships > shipyard->getSpawnMaximum()) {
+            if (shipyard.action->type == ActionType::SPAWN) {
+                double spawnCost = config().spawnCost * shipyard.action->ships;
+                if (spawnCost > player.kore || ships > shipyard.getSpawnMaximum()) {
                     continue;
                 }
 
-                shipyard->ships += ships;
-                player->kore -= spawnCost;
+                shipyard.ships += ships;
+                player.kore -= spawnCost;
             } else {
-                if (ships > shipyard->ships) {
+                if (ships > shipyard.ships) {
                     continue;
                 }
 
-                std::string flightPlan = shipyard->action->flightPlan.toString();
-
-                int maxFlightPlanLength = std::floor(2 * std::log(ships)) + 1;
-                if (flightPlan.size() > maxFlightPlanLength) {
-                    flightPlan = flightPlan.substr(0, maxFlightPlanLength);
-                }
-
-                shipyard->ships -= ships;
-
-                auto newFleet = std::make_unique<Fleet>();
-                newFleet->id = turnResolutionGenerateId();
-                newFleet->cell = shipyard->cell;
-                newFleet->player = shipyard->player;
-                newFleet->kore = 0.0;
-                newFleet->ships = ships;
-                newFleet->direction = shipyard->action->flightPlan[0].direction;
-                newFleet->flightPlan = FlightPlan::parse(flightPlan);
-
-                fleetsById[newFleet->id] = newFleet.get();
-
-                player->fleets.push_back(std::move(newFleet));
+                int maxFlightPlanLength = _context->getMaxFlightPlanLength(ships);
+
+                shipyard.ships -= ships;
+
+                // Launched fleets are linked to a cell once they move in turnResolutionFleetsUpdate()
+                Fleet newFleet;
+                newFleet.id = turnResolutionGenerateId();
+                newFleet.cell = shipyard.cell;
+                newFleet.player = shipyard.player;
+                newFleet.kore = 0.0;
+                newFleet.ships = ships;
+                newFleet.direction = shipyard.action->flightPlan[0].direction;
+                newFleet.flightPlan = shipyard.action->flightPlan;
+                newFleet.flightPlan.truncate(maxFlightPlanLength);
+                newFleet.trajectory = Trajectory(newFleet.cell, newFleet.direction, newFleet.flightPlan, config().size);
+                newFleet.previousInCell = -1;
+                newFleet.nextInCell = -1;
+
+                startGeneration();
+                fleets.push_back(std::move(newFleet));
             }
         }
 
-        for (const auto &shipyard : player->shipyards) {
-            shipyard->action.reset();
-            shipyard->turnsControlled++;
+        for (auto &shipyard : shipyardsOf(player.id)) {
+            shipyard.action.reset();
+            shipyard.turnsControlled++;
         }
     }
 }
 
+template<int Size>
 void Board::turnResolutionFleetsUpdate() {
-    for (auto &player : players) {
-        auto it = player->fleets.begin();
-        while (it != player->fleets.end()) {
-            auto *fleet = it->get();
+    _occupiedCells.clear();
 
-            auto &flightPlan = fleet->flightPlan;
-
-            while (!flightPlan.empty()
-                   && flightPlan.front().type == FlightPlanPartType::MOVE
-                   && flightPlan.front().steps == 0) {
-                flightPlan.pop_front();
+    for (auto &player : players) {
+        for (int i = 0; i < static_cast<int>(fleets.size());) {
+            auto &fleet = fleets[i];
+            if (fleet.player != player.id) {
+                i++;
+                continue;
             }
 
-            if (!flightPlan.empty()
-                && flightPlan.front().type == FlightPlanPartType::CONVERT
-                && fleet->ships >= config.convertCost
-                && fleet->cell->shipyard == nullptr) {
-                player->kore += fleet->kore;
-                fleet->cell->kore = 0.0;
+            Cell &currentCell = cells.at(fleet.cell);
 
-                auto newShipyard = std::make_unique<Shipyard>();
-                newShipyard->id = turnResolutionGenerateId();
-                newShipyard->cell = fleet->cell;
-                newShipyard->player = fleet->player;
-                newShipyard->ships = fleet->ships - config.convertCost;
-                newShipyard->turnsControlled = 0;
+            if (fleet.trajectory.convertsNext()
+                && fleet.ships >= config().convertCost
+                && currentCell.shipyard == -1) {
+                player.kore += fleet.kore;
+                cells.kore(currentCell) = 0.0;
 
-                shipyardsById[newShipyard->id] = newShipyard.get();
+                Shipyard newShipyard;
+                newShipyard.id = turnResolutionGenerateId();
+                newShipyard.cell = fleet.cell;
+                newShipyard.player = fleet.player;
+                newShipyard.ships = fleet.ships - config().convertCost;
+                newShipyard.turnsControlled = 0;
 
-                newShipyard->cell->shipyard = newShipyard.get();
-                player->shipyards.push_back(std::move(newShipyard));
+                addShipyard(std::move(newShipyard));
 
-                fleet->cell->removeFleet(fleet);
-                it = player->fleets.erase(it);
+                removeFleet(i);
+                i++;
                 continue;
             }
 
-            while (!flightPlan.empty() && flightPlan.front().type == FlightPlanPartType::CONVERT) {
-                flightPlan.pop_front();
-            }
-
-            if (!flightPlan.empty()) {
-                switch (flightPlan.front().type) {
-                    case FlightPlanPartType::TURN:
-                        fleet->direction = flightPlan.front().direction;
-                        flightPlan.pop_front();
-                        break;
-                    case FlightPlanPartType::MOVE:
-                        if (flightPlan.front().steps == 1) {
-                            flightPlan.pop_front();
-                        } else {
-                            flightPlan.front().steps--;
-                        }
-                        break;
-                    case FlightPlanPartType::CONVERT:
-                        break;
-                }
-            }
+            fleet.direction = fleet.trajectory.advance();
 
-            Cell *currentCell = fleet->cell;
-            Cell *newCell = nullptr;
-
-            switch (fleet->direction) {
-                case Direction::NORTH:
-                    newCell = &cells.at(currentCell->x, currentCell->y + 1);
-                    break;
-                case Direction::EAST:
-                    newCell = &cells.at(currentCell->x + 1, currentCell->y);
-                    break;
-                case Direction::SOUTH:
-                    newCell = &cells.at(currentCell->x, currentCell->y - 1);
-                    break;
-                case Direction::WEST:
-                    newCell = &cells.at(currentCell->x - 1, currentCell->y);
-                    break;
-            }
+            int newCell = cells.neighbor<Size>(fleet.cell, fleet.direction);
 
-            currentCell->removeFleet(fleet);
-            fleet->cell = newCell;
-            fleet->cell->fleets.push_back(fleet);
+            unlinkFleet(i);
+            fleet.cell = newCell;
+            linkFleet(i);
+            _occupiedCells.push_back(newCell);
 
-            it++;
+            i++;
         }
     }
+
+    // Later phases visit the cells in the same order as a scan over the whole board would
+    std::sort(_occupiedCells.begin(), _occupiedCells.end());
+    _occupiedCells.erase(std::unique(_occupiedCells.begin(), _occupiedCells.end()), _occupiedCells.end());
 }
 
 void Board::turnResolutionAlliedFleetsCoalesce() {
+    thread_local std::vector<int> alliedFleets;
+
     for (const auto &player : players) {
-        for (const auto &cell : cells) {
-            if (cell.fleets.size() < 2) {
+        for (int cellIndex : _occupiedCells) {
+            const auto &cell = cells.at(cellIndex);
+            if (!cell.hasMultipleFleets()) {
                 continue;
             }
 
-            std::vector<Fleet *> alliedFleets;
-            for (const auto &fleet : cell.fleets) {
-                if (fleet->player == player.get()) {
+            alliedFleets.clear();
+            for (int fleet : fleetsAt(cell)) {
+                if (fleets[fleet].player == player.id) {
                     alliedFleets.push_back(fleet);
                 }
             }
@@ -274,231 +593,290 @@ void Board::turnResolutionAlliedFleetsCoalesce() {
                 continue;
             }
 
-            const auto &biggestAlly = *std::max_element(alliedFleets.begin(), alliedFleets.end(),
-                                                        [](const Fleet *a, const Fleet *b) {
-                                                            if (a->ships == b->ships) {
-                                                                if (a->kore == b->kore) {
-                                                                    return a->direction > b->direction;
-                                                                } else {
-                                                                    return a->kore < b->kore;
-                                                                }
-                                                            } else {
-                                                                return a->ships < b->ships;
-                                                            }
-                                                        });
-
-            for (const auto &fleet : alliedFleets) {
+            int biggestAlly = *std::max_element(alliedFleets.begin(), alliedFleets.end(),
+                                                [&](int aIndex, int bIndex) {
+                                                    const auto &a = fleets[aIndex];
+                                                    const auto &b = fleets[bIndex];
+
+                                                    if (a.ships == b.ships) {
+                                                        if (a.kore == b.kore) {
+                                                            return a.direction > b.direction;
+                                                        } else {
+                                                            return a.kore < b.kore;
+                                                        }
+                                                    } else {
+                                                        return a.ships < b.ships;
+                                                    }
+                                                });
+
+            for (int fleet : alliedFleets) {
                 if (fleet == biggestAlly) {
                     continue;
                 }
 
-                biggestAlly->kore += fleet->kore;
-                biggestAlly->ships += fleet->ships;
+                fleets[biggestAlly].kore += fleets[fleet].kore;
+                fleets[biggestAlly].ships += fleets[fleet].ships;
+            }
 
-                fleetsById.erase(fleetsById.find(fleet->id));
-                fleet->remove();
+            for (int fleet : alliedFleets) {
+                if (fleet != biggestAlly) {
+                    removeFleet(fleet);
+                }
             }
         }
     }
 }
 
 void Board::turnResolutionFleetCollisions() {
-    for (const auto &cell : cells) {
-        if (cell.fleets.size() < 2) {
+    thread_local std::vector<int> battlingFleets;
+
+    for (int cellIndex : _occupiedCells) {
+        auto &cell = cells.at(cellIndex);
+        if (!cell.hasMultipleFleets()) {
             continue;
         }
 
-        Fleet *biggestFleet = nullptr;
+        auto cellFleets = fleetsAt(cell);
+
+        int biggestFleet = -1;
         bool tied = false;
 
-        for (const auto &fleet : cell.fleets) {
-            if (biggestFleet == nullptr) {
+        for (int fleet : cellFleets) {
+            if (biggestFleet == -1) {
                 biggestFleet = fleet;
-            } else if (fleet->ships > biggestFleet->ships) {
+            } else if (fleets[fleet].ships > fleets[biggestFleet].ships) {
                 biggestFleet = fleet;
-            } else if (fleet->ships == biggestFleet->ships) {
+            } else if (fleets[fleet].ships == fleets[biggestFleet].ships) {
                 tied = true;
                 break;
             }
         }
 
-        std::vector<Fleet *> battlingFleets(cell.fleets);
-        for (const auto &fleet : battlingFleets) {
+        battlingFleets.assign(cellFleets.begin(), cellFleets.end());
+        for (int fleet : battlingFleets) {
             if (!tied && biggestFleet == fleet) {
                 continue;
             }
 
             if (tied) {
-                if (fleet->cell->shipyard == nullptr) {
-                    fleet->cell->kore += fleet->kore;
+                if (cell.shipyard == -1) {
+                    cells.kore(cell) += fleets[fleet].kore;
                 } else {
-                    fleet->cell->shipyard->player->kore += fleet->kore;
+                    players[shipyards[cell.shipyard].player].kore += fleets[fleet].kore;
                 }
             } else {
-                biggestFleet->kore += fleet->kore;
-                biggestFleet->ships -= fleet->ships;
+                fleets[biggestFleet].kore += fleets[fleet].kore;
+                fleets[biggestFleet].ships -= fleets[fleet].ships;
             }
+        }
 
-            fleetsById.erase(fleetsById.find(fleet->id));
-            fleet->remove();
+        for (int fleet : battlingFleets) {
+            if (tied || biggestFleet != fleet) {
+                removeFleet(fleet);
+            }
         }
     }
 }
 
 void Board::turnResolutionShipyardCollision() {
-    for (const auto &cell : cells) {
-        if (cell.shipyard == nullptr || cell.fleets.empty()) {
+    for (int cellIndex : _occupiedCells) {
+        auto &cell = cells.at(cellIndex);
+        if (cell.shipyard == -1 || !cell.hasFleets()) {
             continue;
         }
 
-        const auto &shipyard = cell.shipyard;
-        const auto &fleet = cell.fleets[0];
+        int shipyardIndex = cell.shipyard;
+        int fleetIndex = cell.firstFleet;
 
-        if (shipyard->player == fleet->player) {
-            fleet->player->kore += fleet->kore;
-            shipyard->ships += fleet->ships;
+        auto &shipyard = shipyards[shipyardIndex];
+        auto &fleet = fleets[fleetIndex];
 
-            fleetsById.erase(fleetsById.find(fleet->id));
-            fleet->remove();
+        if (shipyard.player == fleet.player) {
+            players[fleet.player].kore += fleet.kore;
+            shipyard.ships += fleet.ships;
+
+            removeFleet(fleetIndex);
         } else {
-            if (fleet->ships <= shipyard->ships) {
-                shipyard->ships -= fleet->ships;
-                shipyard->player->kore += fleet->kore;
+            if (fleet.ships <= shipyard.ships) {
+                shipyard.ships -= fleet.ships;
+                players[shipyard.player].kore += fleet.kore;
 
-                fleetsById.erase(fleetsById.find(fleet->id));
-                fleet->remove();
+                removeFleet(fleetIndex);
             } else {
-                auto newShipyard = std::make_unique<Shipyard>();
-                newShipyard->id = turnResolutionGenerateId();
-                newShipyard->cell = shipyard->cell;
-                newShipyard->player = fleet->player;
-                newShipyard->ships = fleet->ships - shipyard->ships;
-                newShipyard->turnsControlled = 1;
-
-                newShipyard->player->kore += fleet->kore;
-
-                shipyardsById[newShipyard->id] = newShipyard.get();
+                Shipyard newShipyard;
+                newShipyard.id = turnResolutionGenerateId();
+                newShipyard.cell = shipyard.cell;
+                newShipyard.player = fleet.player;
+                newShipyard.ships = fleet.ships - shipyard.ships;
+                newShipyard.turnsControlled = 1;
 
-                shipyardsById.erase(shipyardsById.find(shipyard->id));
-                shipyard->remove();
+                players[newShipyard.player].kore += fleet.kore;
 
-                fleetsById.erase(fleetsById.find(fleet->id));
-                fleet->remove();
+                removeShipyard(shipyardIndex);
+                removeFleet(fleetIndex);
 
-                newShipyard->cell->shipyard = newShipyard.get();
-                newShipyard->player->shipyards.push_back(std::move(newShipyard));
+                addShipyard(std::move(newShipyard));
             }
         }
     }
 }
 
+template<int Size>
 void Board::turnResolutionFleetToFleetDamage() {
-    std::unordered_map<Fleet *, std::vector<std::pair<Fleet *, int>>> incomingDamage;
-
-    int directions[4][2] = {{1,  0},
-                            {-1, 0},
-                            {0,  1},
-                            {0,  -1}};
+    // A fleet has at most one attacker per direction
+    struct IncomingDamage {
+        int attackers[4];
+        int damage[4];
+        int count;
+    };
+
+    struct KoreTransfer {
+        int attackerCell;
+        int deadCell;
+        double kore;
+    };
+
+    // Reused across calls, so the phase does not allocate once the buffers have grown to the largest board seen
+    thread_local std::vector<IncomingDamage> incomingDamage;
+    thread_local std::vector<int> damagedFleets;
+    thread_local std::vector<int> deadFleets;
+    thread_local std::vector<KoreTransfer> koreTransfers;
+
+    incomingDamage.resize(fleets.size());
+    damagedFleets.clear();
+
+    Direction directions[4] = {Direction::EAST, Direction::WEST, Direction::NORTH, Direction::SOUTH};
 
     for (const auto &player : players) {
-        for (const auto &fleet : player->fleets) {
-            for (const auto &[dx, dy] : directions) {
-                const auto &adjacentCell = cells.at(fleet->cell->x + dx, fleet->cell->y + dy);
-                if (adjacentCell.fleets.empty()) {
+        for (int i = 0, iMax = fleets.size(); i < iMax; i++) {
+            const auto &fleet = fleets[i];
+            if (fleet.player != player.id) {
+                continue;
+            }
+
+            auto &incoming = incomingDamage[i];
+            incoming.count = 0;
+
+            for (auto direction : directions) {
+                const auto &adjacentCell = cells.at(cells.neighbor<Size>(fleet.cell, direction));
+                if (!adjacentCell.hasFleets()) {
                     continue;
                 }
 
-                const auto &attackingFleet = adjacentCell.fleets[0];
-                if (attackingFleet->player == player.get()) {
+                int attackingFleet = adjacentCell.firstFleet;
+                if (fleets[attackingFleet].player == player.id) {
                     continue;
                 }
 
-                incomingDamage[fleet.get()].push_back({attackingFleet, attackingFleet->ships});
+                incoming.attackers[incoming.count] = attackingFleet;
+                incoming.damage[incoming.count] = fleets[attackingFleet].ships;
+                incoming.count++;
+            }
+
+            if (incoming.count > 0) {
+                damagedFleets.push_back(i);
             }
         }
     }
 
-    if (incomingDamage.empty()) {
+    if (damagedFleets.empty()) {
         return;
     }
 
-    std::unordered_map<Cell *, std::vector<std::pair<Cell *, double>>> koreToDistribute;
-    std::vector<Fleet *> deadFleets;
+    deadFleets.clear();
+    koreTransfers.clear();
+
+    for (int fleetIndex : damagedFleets) {
+        auto &fleet = fleets[fleetIndex];
+        const auto &incoming = incomingDamage[fleetIndex];
 
-    for (const auto &[fleet, attackingFleets] : incomingDamage) {
         int totalDamage = 0;
-        for (const auto &[attackingFleet, damage] : attackingFleets) {
-            totalDamage += damage;
+        for (int i = 0; i < incoming.count; i++) {
+            totalDamage += incoming.damage[i];
         }
 
-        if (totalDamage >= fleet->ships) {
-            fleet->cell->kore += fleet->kore / 2;
+        if (totalDamage >= fleet.ships) {
+            cells.kore(fleet.cell) += fleet.kore / 2;
 
-            double koreToSplit = fleet->kore / 2;
-            for (const auto &[attackingFleet, damage] : attackingFleets) {
-                double portion = koreToSplit * (((double) damage) / ((double) totalDamage));
-                koreToDistribute[attackingFleet->cell].push_back({fleet->cell, portion});
+            double koreToSplit = fleet.kore / 2;
+            for (int i = 0; i < incoming.count; i++) {
+                double portion = koreToSplit * (((double) incoming.damage[i]) / ((double) totalDamage));
+                koreTransfers.push_back({fleets[incoming.attackers[i]].cell, fleet.cell, portion});
             }
 
-            deadFleets.push_back(fleet);
+            deadFleets.push_back(fleetIndex);
         } else {
-            fleet->ships -= totalDamage;
+            fleet.ships -= totalDamage;
         }
     }
 
-    if (koreToDistribute.empty()) {
+    if (koreTransfers.empty()) {
         return;
     }
 
-    for (const auto &fleet : deadFleets) {
-        fleetsById.erase(fleetsById.find(fleet->id));
-        fleet->remove();
+    for (int fleet : deadFleets) {
+        removeFleet(fleet);
     }
 
-    for (const auto &[cell, portions] : koreToDistribute) {
-        if (cell->fleets.empty()) {
-            for (const auto &[alternativeCell, kore] : portions) {
-                alternativeCell->kore += kore;
-            }
+    // Kore goes to the attacker if it survived, otherwise it drops onto the cell of the destroyed fleet
+    for (const auto &transfer : koreTransfers) {
+        const auto &attackerCell = cells.at(transfer.attackerCell);
+
+        if (!attackerCell.hasFleets()) {
+            cells.kore(transfer.deadCell) += transfer.kore;
         } else {
-            for (const auto &[alternativeCell, kore] : portions) {
-                cell->fleets[0]->kore += kore;
-            }
+            fleets[attackerCell.firstFleet].kore += transfer.kore;
         }
     }
 }
 
 void Board::turnResolutionKoreMining() {
     for (const auto &player : players) {
-        for (const auto &fleet : player->fleets) {
-            if (fleet->cell->kore == 0.0) {
+        for (auto &fleet : fleetsOf(player.id)) {
+            double &cellKore = cells.kore(fleet.cell);
+            if (cellKore == 0.0) {
                 continue;
             }
 
-            double minedKore = fleet->cell->kore * fleet->getCollectionRate();
+            double minedKore = cellKore * _context->getCollectionRate(fleet.ships);
 
-            fleet->kore += minedKore;
-            fleet->cell->kore -= minedKore;
+            fleet.kore += minedKore;
+            cellKore -= minedKore;
         }
     }
 }
 
 void Board::turnResolutionKoreRegeneration() {
-    for (auto &cell : cells) {
-        if (cell.shipyard != nullptr || !cell.fleets.empty()) {
-            continue;
+    thread_local std::vector<int> occupiedCells;
+    occupiedCells.clear();
+
+    for (const auto &shipyard : shipyards) {
+        if (shipyard.player != REMOVED) {
+            occupiedCells.push_back(shipyard.cell);
         }
+    }
 
-        if (cell.kore < config.maxRegenCellKore) {
-            cell.kore += cell.kore * config.regenRate;
+    for (const auto &fleet : fleets) {
+        if (fleet.player != REMOVED) {
+            occupiedCells.push_back(fleet.cell);
         }
     }
+
+    // Only the occupied cells are touched, every other cell catches up the next time its kore is read
+    cells.regenerateKore(occupiedCells);
 }
 
 void Board::turnResolutionEndTurn() {
+    if (_hasRemovedEntities) {
+        compactEntities();
+    }
+
     step++;
 }
 
-std::string Board::turnResolutionGenerateId() {
-    return std::to_string(step + 1) + "-" + std::to_string(_idCounter++);
+EntityId Board::turnResolutionGenerateId() {
+    return EntityId::create(step + 1, _idCounter++);
 }
+
+template void Board::nextSized<21>();
+template void Board::nextSized<CellMap::DYNAMIC_SIZE>();
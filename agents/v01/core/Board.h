@@ -1,36 +1,86 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
-#include <string>
-#include <unordered_map>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
+#include <core/CellFleets.h>
 #include <core/CellMap.h>
 #include <core/Configuration.h>
+#include <core/EntityHandle.h>
+#include <core/EntityId.h>
+#include <core/GameContext.h>
 #include <core/Fleet.h>
 #include <core/Player.h>
+#include <core/PlayerEntities.h>
 #include <core/Shipyard.h>
+#include <core/Topology.h>
 
 class Board {
+    struct UndoEntry {
+        int step;
+        int idCounter;
+
+        std::vector<Player> players;
+        std::vector<Shipyard> shipyards;
+        std::vector<Fleet> fleets;
+
+        CellMap::KoreSnapshot kore;
+    };
+
+    friend struct BoardPhases;
+
+    // Player of shipyards and fleets removed during a turn, their slots are compacted away at the end of the turn
+    static constexpr int REMOVED = -1;
+
+    static std::atomic<int> NEXT_GENERATION;
+
+    std::shared_ptr<const GameContext> _context;
+
     int _idCounter;
 
-public:
-    static int COPY_CALLS;
-    static int NEXT_CALLS;
+    int _generation;
+    bool _hasRemovedEntities;
+
+    Board *_parent;
 
-    Configuration config;
+    bool _recordUndo;
+    std::vector<UndoEntry> _undoLog;
+
+    // Cells holding a fleet after the fleets moved this turn, in ascending order
+    std::pmr::vector<int> _occupiedCells;
+
+public:
+    static std::atomic<int> COPY_CALLS;
+    static std::atomic<int> FORK_CALLS;
+    static std::atomic<int> NEXT_CALLS;
 
     int step;
     CellMap cells;
-    std::vector<std::unique_ptr<Player>> players;
+
+    std::pmr::vector<Player> players;
+    std::pmr::vector<Shipyard> shipyards;
+    std::pmr::vector<Fleet> fleets;
 
     int meIndex;
     double remainingOverageTime;
 
-    std::unordered_map<std::string, Shipyard *> shipyardsById;
-    std::unordered_map<std::string, Fleet *> fleetsById;
+    /**
+     * Entities and cells are allocated from the given resource, which must outlive the board. Copies and forks
+     * allocate from the resource of the board they were made from unless they are given another one.
+     */
+    explicit Board(std::shared_ptr<const GameContext> context,
+                   std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    Board(Board &&other) = default;
+    Board &operator=(Board &&other) = default;
 
-    explicit Board(const Configuration &config);
+    [[nodiscard]] const GameContext &context() const;
+    [[nodiscard]] const Configuration &config() const;
+    [[nodiscard]] const Topology &topology() const;
 
     [[nodiscard]] Player &me();
     [[nodiscard]] const Player &me() const;
@@ -38,20 +88,143 @@ public:
     [[nodiscard]] Player &opponent();
     [[nodiscard]] const Player &opponent() const;
 
+    [[nodiscard]] PlayerEntities<std::pmr::vector<Shipyard>> shipyardsOf(int player);
+    [[nodiscard]] PlayerEntities<const std::pmr::vector<Shipyard>> shipyardsOf(int player) const;
+
+    [[nodiscard]] PlayerEntities<std::pmr::vector<Fleet>> fleetsOf(int player);
+    [[nodiscard]] PlayerEntities<const std::pmr::vector<Fleet>> fleetsOf(int player) const;
+
+    [[nodiscard]] Shipyard *shipyardAt(const Cell &cell);
+    [[nodiscard]] const Shipyard *shipyardAt(const Cell &cell) const;
+
+    [[nodiscard]] CellFleets fleetsAt(const Cell &cell) const;
+
+    [[nodiscard]] Shipyard *findShipyard(EntityId id);
+    [[nodiscard]] const Shipyard *findShipyard(EntityId id) const;
+    [[nodiscard]] Fleet *findFleet(EntityId id);
+    [[nodiscard]] const Fleet *findFleet(EntityId id) const;
+
+    [[nodiscard]] int getShipCount(int player) const;
+
+    [[nodiscard]] EntityHandle handleOf(const Shipyard &shipyard) const;
+    [[nodiscard]] EntityHandle handleOf(const Fleet &fleet) const;
+
+    /**
+     * Returns the entity the handle refers to, or nullptr when the handle is stale or the entity was removed.
+     * Copies and forks share the generation of their source until either of them adds, compacts or reorders its
+     * entities, or undoes a turn.
+     */
+    [[nodiscard]] Shipyard *getShipyard(EntityHandle handle);
+    [[nodiscard]] Fleet *getFleet(EntityHandle handle);
+
+    Shipyard &addShipyard(Shipyard shipyard);
+    Fleet &addFleet(Fleet fleet);
+
+    /**
+     * Stably sorts the shipyards of the player among the positions they already take, the other shipyards keep
+     * their positions. Handles taken before become stale, as the board starts a new generation.
+     */
+    template<typename Compare>
+    void sortShipyards(int player, Compare compare) {
+        std::vector<int> positions;
+        std::vector<Shipyard> sorted;
+        for (int i = 0, iMax = shipyards.size(); i < iMax; i++) {
+            if (shipyards[i].player == player) {
+                positions.push_back(i);
+                sorted.push_back(std::move(shipyards[i]));
+            }
+        }
+
+        std::stable_sort(sorted.begin(), sorted.end(), compare);
+
+        for (int i = 0, iMax = positions.size(); i < iMax; i++) {
+            shipyards[positions[i]] = std::move(sorted[i]);
+        }
+
+        linkShipyards();
+        startGeneration();
+    }
+
+    [[nodiscard]] std::pmr::memory_resource *resource() const;
+
     [[nodiscard]] Board copy() const;
+    [[nodiscard]] Board copy(std::pmr::memory_resource *resource) const;
+
+    /**
+     * Creates a board that shares its cells with this board until either of them modifies them.
+     * The returned board keeps a reference to this board, which must outlive it when commit() or discard() is used.
+     * Like copies, it starts without any turns to undo.
+     */
+    [[nodiscard]] Board fork();
+    [[nodiscard]] Board fork(std::pmr::memory_resource *resource);
+
+    /**
+     * Overwrites the state of the board this board was forked from with the state of this board. When the boards
+     * allocate from different resources the cells are copied rather than shared, so the parent does not depend on
+     * the resource of this board. The parent can then undo the turns this board recorded followed by its own, unless
+     * the resources differ, in which case it has no turns left to undo.
+     */
+    void commit();
+
+    /**
+     * Resets this board to the current state of the board it was forked from.
+     */
+    void discard();
+
+    /**
+     * When enabled, every call to next() records the state it mutates so that undo() can restore it exactly.
+     * Disabling recording clears the recorded steps.
+     */
+    void setRecordUndo(bool recordUndo);
 
+    [[nodiscard]] bool canUndo() const;
+
+    /**
+     * Reverts the most recent recorded call to next().
+     */
+    void undo();
+
+    /**
+     * Resolves one turn. Boards of the standard size use lookups specialized for that size at compile time.
+     */
     void next();
 
 private:
+    Board(const Board &other);
+    Board(const Board &other, std::pmr::memory_resource *resource);
+    Board &operator=(const Board &other) = default;
+
+    /**
+     * Makes every handle taken so far stale, for when entities move to other indices or indices appear or vanish.
+     */
+    void startGeneration();
+
+    void linkShipyards();
+
+    void recordUndoEntry();
+
+    template<int Size>
+    void nextSized();
+
+    void removeShipyard(int index);
+    void removeFleet(int index);
+
+    void linkFleet(int index);
+    void unlinkFleet(int index);
+
+    void compactEntities();
+
     void turnResolutionSpawningAndLaunching();
+    template<int Size>
     void turnResolutionFleetsUpdate();
     void turnResolutionAlliedFleetsCoalesce();
     void turnResolutionFleetCollisions();
     void turnResolutionShipyardCollision();
+    template<int Size>
     void turnResolutionFleetToFleetDamage();
     void turnResolutionKoreMining();
     void turnResolutionKoreRegeneration();
     void turnResolutionEndTurn();
 
-    std::string turnResolutionGenerateId();
+    EntityId turnResolutionGenerateId();
 };
@@ -0,0 +1,26 @@
+#include <core/BoardArena.h>
+
+BoardArena::BoardArena()
+        : _buffer(INITIAL_SIZE),
+          _resource(_buffer.data(), _buffer.size(), std::pmr::new_delete_resource()),
+          _depth(0) {}
+
+BoardArena::Scope::Scope() : _arena(BoardArena::local()) {
+    _arena._depth++;
+}
+
+BoardArena::Scope::~Scope() {
+    // Tasks run while waiting for other tasks open nested scopes, their boards are released with the outermost one
+    if (--_arena._depth == 0) {
+        _arena._resource.release();
+    }
+}
+
+std::pmr::memory_resource *BoardArena::Scope::resource() const {
+    return &_arena._resource;
+}
+
+BoardArena &BoardArena::local() {
+    thread_local BoardArena arena;
+    return arena;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * A monotonic arena for short-lived boards. Allocating bumps a pointer and deallocating does nothing, the memory is
+ * reclaimed all at once when the outermost scope on the thread ends. Every thread has its own arena, so boards on
+ * different threads never contend for memory.
+ *
+ * Boards allocated from the arena must be destroyed before the scope they were created in ends.
+ */
+class BoardArena {
+    static constexpr std::size_t INITIAL_SIZE = 1 << 20;
+
+    std::vector<std::byte> _buffer;
+    std::pmr::monotonic_buffer_resource _resource;
+    int _depth;
+
+    BoardArena();
+
+public:
+    class Scope {
+        BoardArena &_arena;
+
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope &other) = delete;
+        Scope &operator=(const Scope &other) = delete;
+
+        [[nodiscard]] std::pmr::memory_resource *resource() const;
+    };
+
+    BoardArena(const BoardArena &other) = delete;
+    BoardArena &operator=(const BoardArena &other) = delete;
+
+    /**
+     * Returns the arena of the calling thread.
+     */
+    [[nodiscard]] static BoardArena &local();
+};
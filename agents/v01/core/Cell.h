@@ -1,21 +1,21 @@
 #pragma once
 
-#include <vector>
-
-class Shipyard;
-
-class Fleet;
+#include <type_traits>
 
 struct Cell {
     int x;
     int y;
+    int index;
 
-    double kore;
+    int shipyard;
 
-    Shipyard *shipyard;
-    std::vector<Fleet *> fleets;
+    // The fleets in this cell form a list through Fleet::previousInCell and Fleet::nextInCell, in the order they
+    // entered the cell, so cells own no memory and linking or unlinking a fleet takes constant time
+    int firstFleet;
+    int lastFleet;
 
-    [[nodiscard]] int distanceTo(const Cell &other) const;
-
-    void removeFleet(const Fleet *Fleet);
+    [[nodiscard]] bool hasFleets() const;
+    [[nodiscard]] bool hasMultipleFleets() const;
 };
+
+static_assert(std::is_trivially_copyable_v<Cell>, "Cells are copied whenever a board detaches its cells");
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include <core/Cell.h>
+#include <core/Fleet.h>
+
+/**
+ * The indices of the fleets in a cell, in the order they entered it. Unlinking the current fleet invalidates an
+ * iterator, so fleets are collected first when some of them are removed.
+ */
+class CellFleets {
+    const Fleet *_fleets;
+    int _first;
+
+public:
+    class Iterator {
+        const Fleet *_fleets;
+        int _index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int *;
+        using reference = int;
+
+        Iterator(const Fleet *fleets, int index) : _fleets(fleets), _index(index) {}
+
+        [[nodiscard]] int operator*() const {
+            return _index;
+        }
+
+        Iterator &operator++() {
+            _index = _fleets[_index].nextInCell;
+            return *this;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator &other) const {
+            return _index == other._index;
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    CellFleets(const Fleet *fleets, const Cell &cell) : _fleets(fleets), _first(cell.firstFleet) {}
+
+    [[nodiscard]] Iterator begin() const {
+        return {_fleets, _first};
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return {_fleets, -1};
+    }
+};
@@ -1,29 +1,89 @@
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
 #include <core/CellMap.h>
 
-CellMap::CellMap(int size) : _cells(size * size), _size(size) {
+CellMap::CellMap(const Configuration &config, std::pmr::memory_resource *resource)
+        : _resource(resource),
+          _cells(std::allocate_shared<std::pmr::vector<Cell>>(std::pmr::polymorphic_allocator<std::byte>(resource),
+                                                              config.size * config.size)),
+          _kore(std::allocate_shared<std::pmr::vector<KoreCell>>(std::pmr::polymorphic_allocator<std::byte>(resource),
+                                                                 config.size * config.size,
+                                                                 KoreCell{0.0, 0})),
+          _topology(Topology::get(config.size)),
+          _size(config.size),
+          _regenRate(config.regenRate),
+          _maxRegenCellKore(config.maxRegenCellKore),
+          _regenerations(0) {
+    int size = config.size;
+
     for (int y = 0; y < size; y++) {
         for (int x = 0; x < size; x++) {
-            auto &cell = _cells[cellToIndex(x, y)];
+            int index = cellToIndex(x, y);
+
+            auto &cell = (*_cells)[index];
             cell.x = x;
             cell.y = y;
+            cell.index = index;
+            cell.shipyard = -1;
+            cell.firstFleet = -1;
+            cell.lastFleet = -1;
         }
     }
 }
 
+CellMap::CellMap(const CellMap &other, std::pmr::memory_resource *resource)
+        : _resource(resource),
+          _cells(other._cells),
+          _kore(other._kore),
+          _topology(other._topology),
+          _size(other._size),
+          _regenRate(other._regenRate),
+          _maxRegenCellKore(other._maxRegenCellKore),
+          _regenerations(other._regenerations) {}
+
+CellMap &CellMap::operator=(const CellMap &other) {
+    _cells = other._cells;
+    _kore = other._kore;
+    _topology = other._topology;
+    _size = other._size;
+    _regenRate = other._regenRate;
+    _maxRegenCellKore = other._maxRegenCellKore;
+    _regenerations = other._regenerations;
+
+    return *this;
+}
+
+CellMap &CellMap::operator=(CellMap &&other) {
+    _cells = std::move(other._cells);
+    _kore = std::move(other._kore);
+    _topology = std::move(other._topology);
+    _size = other._size;
+    _regenRate = other._regenRate;
+    _maxRegenCellKore = other._maxRegenCellKore;
+    _regenerations = other._regenerations;
+
+    return *this;
+}
+
 Cell &CellMap::at(int index) {
-    return _cells[index];
+    detachCells();
+    return (*_cells)[index];
 }
 
 const Cell &CellMap::at(int index) const {
-    return _cells[index];
+    return (*_cells)[index];
 }
 
 Cell &CellMap::at(int x, int y) {
-    return _cells[cellToIndex(x, y)];
+    detachCells();
+    return (*_cells)[cellToIndex(x, y)];
 }
 
 const Cell &CellMap::at(int x, int y) const {
-    return _cells[cellToIndex(x, y)];
+    return (*_cells)[cellToIndex(x, y)];
 }
 
 Cell &CellMap::at(const Cell &other) {
@@ -34,20 +94,114 @@ const Cell &CellMap::at(const Cell &other) const {
     return at(other.x, other.y);
 }
 
-std::vector<Cell>::iterator CellMap::begin() {
-    return _cells.begin();
+double &CellMap::kore(int index) {
+    detachKore();
+
+    auto &cell = (*_kore)[index];
+    cell.kore = regenerate(cell.kore, _regenerations - cell.regenerations);
+    cell.regenerations = _regenerations;
+
+    return cell.kore;
+}
+
+double CellMap::kore(int index) const {
+    const auto &cell = (*_kore)[index];
+    return regenerate(cell.kore, _regenerations - cell.regenerations);
+}
+
+double &CellMap::kore(const Cell &cell) {
+    return kore(cell.index);
+}
+
+double CellMap::kore(const Cell &cell) const {
+    return kore(cell.index);
+}
+
+void CellMap::regenerateKore(const std::vector<int> &skippedCells) {
+    if (!skippedCells.empty()) {
+        detachKore();
+    }
+
+    // Skipped cells are brought up to date and then marked as regenerated without changing
+    for (int index : skippedCells) {
+        auto &cell = (*_kore)[index];
+        cell.kore = regenerate(cell.kore, _regenerations - cell.regenerations);
+        cell.regenerations = _regenerations + 1;
+    }
+
+    _regenerations++;
+}
+
+CellMap::KoreSnapshot CellMap::saveKore() const {
+    return {_kore, _regenerations};
 }
 
-std::vector<Cell>::const_iterator CellMap::begin() const {
-    return _cells.begin();
+void CellMap::restoreKore(const KoreSnapshot &snapshot) {
+    // The snapshot stays shared, so the next write detaches from it like from any other copy
+    _kore = snapshot.kore;
+    _regenerations = snapshot.regenerations;
 }
 
-std::vector<Cell>::iterator CellMap::end() {
-    return _cells.end();
+int CellMap::count() const {
+    return _size * _size;
 }
 
-std::vector<Cell>::const_iterator CellMap::end() const {
-    return _cells.end();
+std::pmr::vector<Cell>::iterator CellMap::begin() {
+    detachCells();
+    return _cells->begin();
+}
+
+std::pmr::vector<Cell>::const_iterator CellMap::begin() const {
+    return _cells->begin();
+}
+
+std::pmr::vector<Cell>::iterator CellMap::end() {
+    detachCells();
+    return _cells->end();
+}
+
+std::pmr::vector<Cell>::const_iterator CellMap::end() const {
+    return _cells->end();
+}
+
+const Topology &CellMap::topology() const {
+    return *_topology;
+}
+
+bool CellMap::isShared() const {
+    return _cells.use_count() > 1 || _kore.use_count() > 1;
+}
+
+std::pmr::memory_resource *CellMap::resource() const {
+    return _resource;
+}
+
+void CellMap::detach() {
+    detachCells();
+    detachKore();
+}
+
+void CellMap::detachCells() {
+    if (_cells.use_count() > 1) {
+        _cells = std::allocate_shared<std::pmr::vector<Cell>>(std::pmr::polymorphic_allocator<std::byte>(_resource),
+                                                              *_cells);
+    }
+}
+
+void CellMap::detachKore() {
+    if (_kore.use_count() > 1) {
+        _kore = std::allocate_shared<std::pmr::vector<KoreCell>>(std::pmr::polymorphic_allocator<std::byte>(_resource),
+                                                                 *_kore);
+    }
+}
+
+double CellMap::regenerate(double kore, int steps) const {
+    // A cell that reached the maximum never regenerates again, so the loop can stop there
+    for (int i = 0; i < steps && kore < _maxRegenCellKore; i++) {
+        kore += kore * _regenRate;
+    }
+
+    return kore;
 }
 
 constexpr int CellMap::cellToIndex(int x, int y) const {
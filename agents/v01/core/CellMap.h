@@ -1,17 +1,74 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include <core/Cell.h>
+#include <core/Configuration.h>
+#include <core/Direction.h>
+#include <core/Topology.h>
 
+/**
+ * Copies of a CellMap share their cells until one of them requests mutable access, at which point that copy
+ * detaches and gets its own cells. Mutable references are therefore only stable until the map is copied again.
+ *
+ * Kore is stored separately from the cells in a contiguous array indexed by Cell::index, and is shared and detached
+ * independently of the cells. Regeneration is lazy: each cell stores its kore as of the regeneration step it was
+ * last written at, and reading it repeats the regeneration of every step since, so only the cells a turn skips or
+ * writes are touched.
+ *
+ * Cells and kore are allocated from the memory resource of the map. Assigning to a map keeps its resource, so a map
+ * that shares the buffers of another map only allocates from its own resource once it detaches.
+ */
 class CellMap {
-    std::vector<Cell> _cells;
+    using Neighbors = std::array<int, 4>;
+
+public:
+    struct KoreCell {
+        double kore;
+        int regenerations;
+    };
+
+    /**
+     * The kore of a map at one point, sharing its buffer until the map writes kore again.
+     */
+    struct KoreSnapshot {
+        std::shared_ptr<std::pmr::vector<KoreCell>> kore;
+        int regenerations;
+    };
+
+private:
+    std::pmr::memory_resource *_resource;
+    std::shared_ptr<std::pmr::vector<Cell>> _cells;
+    std::shared_ptr<std::pmr::vector<KoreCell>> _kore;
+    std::shared_ptr<const Topology> _topology;
     int _size;
 
+    double _regenRate;
+    double _maxRegenCellKore;
+    int _regenerations;
+
 public:
-    explicit CellMap(int size);
+    /**
+     * Template argument for the size-specialized lookups when the size is only known at runtime.
+     */
+    static constexpr int DYNAMIC_SIZE = 0;
+
+    explicit CellMap(const Configuration &config,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
     CellMap(const CellMap &other) = default;
+    CellMap &operator=(const CellMap &other);
+
+    /**
+     * Shares the buffers of the other map, but allocates from the given resource once detached.
+     */
+    CellMap(const CellMap &other, std::pmr::memory_resource *resource);
+
+    CellMap(CellMap &&other) = default;
+    CellMap &operator=(CellMap &&other);
 
     [[nodiscard]] Cell &at(int index);
     [[nodiscard]] const Cell &at(int index) const;
@@ -22,12 +79,92 @@ public:
     [[nodiscard]] Cell &at(const Cell &other);
     [[nodiscard]] const Cell &at(const Cell &other) const;
 
-    [[nodiscard]] std::vector<Cell>::iterator begin();
-    [[nodiscard]] std::vector<Cell>::const_iterator begin() const;
+    /**
+     * Returns the kore of the cell brought up to date, so it can be written. The reference is only valid until the
+     * map is copied or regenerates.
+     */
+    [[nodiscard]] double &kore(int index);
+    [[nodiscard]] double kore(int index) const;
+
+    [[nodiscard]] double &kore(const Cell &cell);
+    [[nodiscard]] double kore(const Cell &cell) const;
+
+    /**
+     * Regenerates the kore of every cell except the given ones, which may contain duplicates.
+     */
+    void regenerateKore(const std::vector<int> &skippedCells);
+
+    [[nodiscard]] KoreSnapshot saveKore() const;
+    void restoreKore(const KoreSnapshot &snapshot);
+
+    [[nodiscard]] int count() const;
+
+    [[nodiscard]] std::pmr::vector<Cell>::iterator begin();
+    [[nodiscard]] std::pmr::vector<Cell>::const_iterator begin() const;
 
-    [[nodiscard]] std::vector<Cell>::iterator end();
-    [[nodiscard]] std::vector<Cell>::const_iterator end() const;
+    [[nodiscard]] std::pmr::vector<Cell>::iterator end();
+    [[nodiscard]] std::pmr::vector<Cell>::const_iterator end() const;
+
+    /**
+     * Returns the index of the cell adjacent to the given cell in the given direction. When Size matches the size
+     * of this map the lookup uses a table computed at compile time, otherwise it uses the topology of this map.
+     */
+    template<int Size = DYNAMIC_SIZE>
+    [[nodiscard]] int neighbor(int index, Direction direction) const {
+        if constexpr (Size == DYNAMIC_SIZE) {
+            return _topology->neighbor(index, direction);
+        } else {
+            return STATIC_NEIGHBORS<Size>[index][static_cast<int>(direction)];
+        }
+    }
+
+    [[nodiscard]] const Topology &topology() const;
+
+    [[nodiscard]] bool isShared() const;
+
+    [[nodiscard]] std::pmr::memory_resource *resource() const;
+
+    void detach();
 
 private:
+    template<int Size>
+    [[nodiscard]] static constexpr int wrap(int value) {
+        return (value % Size + Size) % Size;
+    }
+
+    template<int Size>
+    [[nodiscard]] static constexpr int staticCellToIndex(int x, int y) {
+        return (Size - wrap<Size>(y) - 1) * Size + wrap<Size>(x);
+    }
+
+    template<int Size>
+    [[nodiscard]] static constexpr std::array<Neighbors, Size * Size> createStaticNeighbors() {
+        std::array<Neighbors, Size * Size> neighbors{};
+
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                auto &cellNeighbors = neighbors[staticCellToIndex<Size>(x, y)];
+                cellNeighbors[static_cast<int>(Direction::NORTH)] = staticCellToIndex<Size>(x, y + 1);
+                cellNeighbors[static_cast<int>(Direction::EAST)] = staticCellToIndex<Size>(x + 1, y);
+                cellNeighbors[static_cast<int>(Direction::SOUTH)] = staticCellToIndex<Size>(x, y - 1);
+                cellNeighbors[static_cast<int>(Direction::WEST)] = staticCellToIndex<Size>(x - 1, y);
+            }
+        }
+
+        return neighbors;
+    }
+
+    template<int Size>
+    static constexpr std::array<Neighbors, Size * Size> STATIC_NEIGHBORS = createStaticNeighbors<Size>();
+
+    void detachCells();
+    void detachKore();
+
+    /**
+     * Applies the given number of regeneration steps one after the other, so the result is bit-identical to
+     * regenerating the cell every turn.
+     */
+    [[nodiscard]] double regenerate(double kore, int steps) const;
+
     [[nodiscard]] constexpr int cellToIndex(int x, int y) const;
 };
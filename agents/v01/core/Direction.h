@@ -1,6 +1,8 @@
 #pragma once
 
-enum class Direction {
+#include <cstdint>
+
+enum class Direction : std::uint8_t {
     NORTH,
     EAST,
     SOUTH,
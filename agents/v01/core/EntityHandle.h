@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * Refers to a shipyard or fleet by its position in the entity lists of a board. Adding entities, compacting the lists
+ * after removals at the end of a turn, reordering them and undoing a turn start a new generation, which makes older
+ * handles stale.
+ */
+struct EntityHandle {
+    int index;
+    int generation;
+};
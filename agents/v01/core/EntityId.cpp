@@ -0,0 +1,37 @@
+#include <cstdlib>
+#include <stdexcept>
+
+#include <core/EntityId.h>
+
+int EntityId::getStep() const {
+    return value >> 16;
+}
+
+int EntityId::getCounter() const {
+    return value & 0xffff;
+}
+
+std::string EntityId::toString() const {
+    return std::to_string(getStep()) + "-" + std::to_string(getCounter());
+}
+
+bool EntityId::operator==(const EntityId &other) const {
+    return value == other.value;
+}
+
+bool EntityId::operator!=(const EntityId &other) const {
+    return value != other.value;
+}
+
+EntityId EntityId::create(int step, int counter) {
+    return {(step << 16) | counter};
+}
+
+EntityId EntityId::parse(const std::string &id) {
+    std::size_t separator = id.find('-');
+    if (separator == std::string::npos || separator == 0 || separator == id.size() - 1) {
+        throw std::invalid_argument("Invalid entity id: " + id);
+    }
+
+    return create(std::atoi(id.substr(0, separator).c_str()), std::atoi(id.substr(separator + 1).c_str()));
+}
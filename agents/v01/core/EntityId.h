@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/**
+ * Kaggle identifies shipyards and fleets by "<step>-<counter>" strings, which are packed into a single integer.
+ * Conversion between the two only happens when communicating with the environment.
+ */
+struct EntityId {
+    int value;
+
+    [[nodiscard]] int getStep() const;
+    [[nodiscard]] int getCounter() const;
+
+    [[nodiscard]] std::string toString() const;
+
+    [[nodiscard]] bool operator==(const EntityId &other) const;
+    [[nodiscard]] bool operator!=(const EntityId &other) const;
+
+    [[nodiscard]] static EntityId create(int step, int counter);
+
+    [[nodiscard]] static EntityId parse(const std::string &id);
+};
+
+namespace std {
+template<>
+struct hash<EntityId> {
+    std::size_t operator()(const EntityId &id) const noexcept {
+        return std::hash<int>{}(id.value);
+    }
+};
+}
@@ -1,14 +1,29 @@
-#include <algorithm>
-#include <cmath>
-
 #include <core/Fleet.h>
-#include <core/Player.h>
 
-double Fleet::getCollectionRate() const {
-    return std::min(std::log(ships) / 20.0, 0.99);
-}
+FlightPlan Fleet::getRemainingFlightPlan() const {
+    FlightPlan remaining = flightPlan;
+
+    for (int i = 0, steps = trajectory.getSteps(); i < steps && !remaining.empty(); i++) {
+        while (!remaining.empty()
+               && remaining.front().type == FlightPlanPartType::MOVE
+               && remaining.front().steps == 0) {
+            remaining.pop_front();
+        }
+
+        while (!remaining.empty() && remaining.front().type == FlightPlanPartType::CONVERT) {
+            remaining.pop_front();
+        }
+
+        if (remaining.empty()) {
+            break;
+        }
+
+        if (remaining.front().type == FlightPlanPartType::MOVE && remaining.front().steps > 1) {
+            remaining.front().steps--;
+        } else {
+            remaining.pop_front();
+        }
+    }
 
-void Fleet::remove() const {
-    cell->removeFleet(this);
-    player->removeFleet(this);
+    return remaining;
 }
@@ -1,23 +1,32 @@
 #pragma once
 
-#include <string>
+#include <type_traits>
 
-#include <core/Cell.h>
 #include <core/Direction.h>
+#include <core/EntityId.h>
 #include <core/FlightPlan.h>
-
-class Player;
+#include <core/Trajectory.h>
 
 struct Fleet {
-    std::string id;
-    Cell *cell;
-    Player *player;
+    EntityId id;
+    int cell;
+    int player;
     double kore;
     int ships;
     Direction direction;
+
+    // The flight plan as of when the fleet entered the board, the fleet follows it through its trajectory
     FlightPlan flightPlan;
+    Trajectory trajectory;
 
-    [[nodiscard]] double getCollectionRate() const;
+    // Neighbors in the fleet list of the cell, -1 at either end and while the fleet is not in a cell yet
+    int previousInCell;
+    int nextInCell;
 
-    void remove() const;
+    /**
+     * Returns the part of the flight plan the fleet has yet to follow, as the game reports it.
+     */
+    [[nodiscard]] FlightPlan getRemainingFlightPlan() const;
 };
+
+static_assert(std::is_trivially_copyable_v<Fleet>, "Fleets are copied with every board and must not own memory");
@@ -1,20 +1,119 @@
+#include <algorithm>
 #include <cstddef>
 #include <stdexcept>
+#include <string>
 
 #include <core/FlightPlan.h>
 
+int FlightPlanPart::getLength() const {
+    if (type != FlightPlanPartType::MOVE) {
+        return 1;
+    }
+
+    int length = 1;
+    for (int remaining = steps; remaining >= 10; remaining /= 10) {
+        length++;
+    }
+
+    return length;
+}
+
+std::uint8_t FlightPlanPart::encode() const {
+    int value = type == FlightPlanPartType::TURN ? static_cast<int>(direction) : 0;
+
+    if (type == FlightPlanPartType::MOVE) {
+        if (steps > 63) {
+            throw std::invalid_argument("Cannot encode a move of " + std::to_string(steps) + " steps");
+        }
+
+        value = steps;
+    }
+
+    return static_cast<int>(type) << 6 | value;
+}
+
+bool FlightPlanPart::operator==(const FlightPlanPart &other) const {
+    return type == other.type && direction == other.direction && steps == other.steps;
+}
+
+bool FlightPlanPart::operator!=(const FlightPlanPart &other) const {
+    return !(*this == other);
+}
+
 FlightPlanPart FlightPlanPart::turn(Direction direction) {
     return {FlightPlanPartType::TURN, direction, 0};
 }
 
 FlightPlanPart FlightPlanPart::move(int steps) {
-    return {FlightPlanPartType::MOVE, Direction::NORTH, steps};
+    if (steps < 0) {
+        throw std::invalid_argument("Cannot move " + std::to_string(steps) + " steps");
+    }
+
+    return {FlightPlanPartType::MOVE, Direction::NORTH, static_cast<std::uint16_t>(std::min(steps, MAX_STEPS))};
 }
 
 FlightPlanPart FlightPlanPart::convert() {
     return {FlightPlanPartType::CONVERT, Direction::NORTH, 0};
 }
 
+FlightPlanPart FlightPlanPart::decode(std::uint8_t part) {
+    int value = part & 0x3f;
+
+    switch (static_cast<FlightPlanPartType>(part >> 6)) {
+        case FlightPlanPartType::TURN:
+            return turn(static_cast<Direction>(value));
+        case FlightPlanPartType::MOVE:
+            return move(value);
+        default:
+            return convert();
+    }
+}
+
+void FlightPlan::push_back(const FlightPlanPart &part) {
+    if (_end == CAPACITY) {
+        throw std::length_error("Flight plans cannot have more than " + std::to_string(CAPACITY) + " parts");
+    }
+
+    _parts[_end++] = part;
+}
+
+int FlightPlan::getLength() const {
+    int length = 0;
+
+    for (const auto &part : *this) {
+        length += part.getLength();
+    }
+
+    return length;
+}
+
+void FlightPlan::truncate(int maxLength) {
+    int length = 0;
+
+    for (int i = _begin; i < _end; i++) {
+        auto &part = _parts[i];
+        int partLength = part.getLength();
+
+        if (length + partLength > maxLength) {
+            int keptLength = maxLength - length;
+
+            // A move that is cut off keeps its leading digits, like the string representation would
+            if (keptLength > 0) {
+                for (int j = keptLength; j < partLength; j++) {
+                    part.steps /= 10;
+                }
+
+                i++;
+            }
+
+            _end = i;
+            return;
+        }
+
+        length += partLength;
+    }
+}
+
 std::string FlightPlan::toString() const {
     std::string str;
 
@@ -48,7 +147,15 @@ std::string FlightPlan::toString() const {
     return str;
 }
 
-FlightPlan FlightPlan::parse(const std::string &flightPlan) {
+bool FlightPlan::operator==(const FlightPlan &other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+}
+
+bool FlightPlan::operator!=(const FlightPlan &other) const {
+    return !(*this == other);
+}
+
+FlightPlan FlightPlan::parse(std::string_view flightPlan) {
     FlightPlan parsedPlan;
 
     for (std::size_t i = 0; i < flightPlan.size(); i++) {
@@ -72,19 +179,19 @@ FlightPlan FlightPlan::parse(const std::string &flightPlan) {
                 break;
             default:
                 if (ch >= '0' && ch <= '9') {
-                    std::string steps;
+                    int steps = 0;
 
                     for (std::size_t j = i; j < flightPlan.size(); i++, j++) {
                         char stepsCh = flightPlan[j];
                         if (stepsCh >= '0' && stepsCh <= '9') {
-                            steps += stepsCh;
+                            steps = std::min(steps * 10 + (stepsCh - '0'), FlightPlanPart::MAX_STEPS);
                         } else {
                             i--;
                             break;
                         }
                     }
 
-                    parsedPlan.push_back(FlightPlanPart::move(std::atoi(steps.c_str())));
+                    parsedPlan.push_back(FlightPlanPart::move(steps));
                 } else {
                     throw std::invalid_argument("Invalid flight plan character: " + std::to_string(ch));
                 }
@@ -93,3 +200,17 @@ FlightPlan FlightPlan::parse(const std::string &flightPlan) {
 
     return parsedPlan;
 }
+
+FlightPlan EncodedFlightPlan::decode() const {
+    FlightPlan flightPlan;
+
+    for (int i = 0; i < partCount; i++) {
+        flightPlan.push_back(FlightPlanPart::decode(parts[i]));
+    }
+
+    return flightPlan;
+}
+
+std::string EncodedFlightPlan::toString() const {
+    return decode().toString();
+}
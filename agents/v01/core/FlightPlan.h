@@ -1,28 +1,143 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
-#include <deque>
+#include <string_view>
 
 #include <core/Direction.h>
 
-enum class FlightPlanPartType {
+enum class FlightPlanPartType : std::uint8_t {
     TURN,
     MOVE,
     CONVERT
 };
 
 struct FlightPlanPart {
+    /**
+     * Longer moves are stored as this many steps, which no game lasts long enough to tell apart.
+     */
+    static constexpr int MAX_STEPS = std::numeric_limits<std::uint16_t>::max();
+
     FlightPlanPartType type;
     Direction direction;
-    int steps;
+    std::uint16_t steps;
+
+    /**
+     * Returns the number of characters of this part in the string representation of a flight plan.
+     */
+    [[nodiscard]] int getLength() const;
+
+    /**
+     * Packs this part into one byte, the type in the upper two bits and the direction or steps in the rest.
+     */
+    [[nodiscard]] std::uint8_t encode() const;
+
+    [[nodiscard]] bool operator==(const FlightPlanPart &other) const;
+    [[nodiscard]] bool operator!=(const FlightPlanPart &other) const;
 
     static FlightPlanPart turn(Direction direction);
     static FlightPlanPart move(int steps);
     static FlightPlanPart convert();
+
+    [[nodiscard]] static FlightPlanPart decode(std::uint8_t part);
 };
 
-struct FlightPlan : public std::deque<FlightPlanPart> {
+/**
+ * The parts of a flight plan stored inline, so fleets and actions can be copied without allocating. Parts are
+ * consumed by advancing a read cursor rather than by moving the remaining parts.
+ */
+class FlightPlan {
+public:
+    static constexpr std::size_t CAPACITY = 24;
+
+private:
+    std::array<FlightPlanPart, CAPACITY> _parts;
+    std::uint8_t _begin;
+    std::uint8_t _end;
+
+public:
+    FlightPlan() : _parts(), _begin(0), _end(0) {}
+
+    [[nodiscard]] std::size_t size() const {
+        return _end - _begin;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return _begin == _end;
+    }
+
+    [[nodiscard]] FlightPlanPart &front() {
+        return _parts[_begin];
+    }
+
+    [[nodiscard]] const FlightPlanPart &front() const {
+        return _parts[_begin];
+    }
+
+    [[nodiscard]] FlightPlanPart &operator[](std::size_t index) {
+        return _parts[_begin + index];
+    }
+
+    [[nodiscard]] const FlightPlanPart &operator[](std::size_t index) const {
+        return _parts[_begin + index];
+    }
+
+    [[nodiscard]] FlightPlanPart *begin() {
+        return _parts.data() + _begin;
+    }
+
+    [[nodiscard]] const FlightPlanPart *begin() const {
+        return _parts.data() + _begin;
+    }
+
+    [[nodiscard]] FlightPlanPart *end() {
+        return _parts.data() + _end;
+    }
+
+    [[nodiscard]] const FlightPlanPart *end() const {
+        return _parts.data() + _end;
+    }
+
+    void pop_front() {
+        _begin++;
+    }
+
+    /**
+     * Appends a part, throwing a std::length_error when the plan is already at capacity.
+     */
+    void push_back(const FlightPlanPart &part);
+
+    [[nodiscard]] int getLength() const;
+
+    /**
+     * Shortens this plan to the first maxLength characters of its string representation, which is how the game
+     * truncates plans that are too long for the size of the launched fleet.
+     */
+    void truncate(int maxLength);
+
     [[nodiscard]] std::string toString() const;
 
-    [[nodiscard]] static FlightPlan parse(const std::string &flightPlan);
+    /**
+     * Compares the remaining parts of both plans.
+     */
+    [[nodiscard]] bool operator==(const FlightPlan &other) const;
+    [[nodiscard]] bool operator!=(const FlightPlan &other) const;
+
+    [[nodiscard]] static FlightPlan parse(std::string_view flightPlan);
+};
+
+/**
+ * A flight plan stored as encoded parts with its cached string length, as found in the flight plan tables.
+ */
+struct EncodedFlightPlan {
+    const std::uint8_t *parts;
+    int partCount;
+    int length;
+
+    [[nodiscard]] FlightPlan decode() const;
+
+    [[nodiscard]] std::string toString() const;
 };
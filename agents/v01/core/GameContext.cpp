@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <core/GameContext.h>
+
+GameContext::GameContext(Configuration config)
+        : _config(std::move(config)),
+          _topology(Topology::get(_config.size)),
+          _collectionRates(SHIP_TABLE_SIZE),
+          _maxFlightPlanLengths(SHIP_TABLE_SIZE) {
+    for (int ships = 1; ships < SHIP_TABLE_SIZE; ships++) {
+        _collectionRates[ships] = computeCollectionRate(ships);
+        _maxFlightPlanLengths[ships] = computeMaxFlightPlanLength(ships);
+    }
+}
+
+std::shared_ptr<const GameContext> GameContext::create(Configuration config) {
+    return std::make_shared<const GameContext>(std::move(config));
+}
+
+const Configuration &GameContext::config() const {
+    return _config;
+}
+
+const Topology &GameContext::topology() const {
+    return *_topology;
+}
+
+double GameContext::getCollectionRate(int ships) const {
+    return ships < SHIP_TABLE_SIZE ? _collectionRates[ships] : computeCollectionRate(ships);
+}
+
+int GameContext::getMaxFlightPlanLength(int ships) const {
+    return ships < SHIP_TABLE_SIZE ? _maxFlightPlanLengths[ships] : computeMaxFlightPlanLength(ships);
+}
+
+double GameContext::computeCollectionRate(int ships) {
+    return std::min(std::log(ships) / 20.0, 0.99);
+}
+
+int GameContext::computeMaxFlightPlanLength(int ships) {
+    return std::floor(2 * std::log(ships)) + 1;
+}
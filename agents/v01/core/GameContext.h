@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <core/Configuration.h>
+#include <core/Topology.h>
+
+/**
+ * Everything about a game that is the same for all of its boards: the configuration, the topology of the board and
+ * lookup tables for rules that would otherwise be recomputed every turn. Built once per game and shared by every
+ * board, so copying a board only copies a pointer to it.
+ */
+class GameContext {
+    // Fleets rarely grow past this many ships, larger fleets compute the rules directly
+    static constexpr int SHIP_TABLE_SIZE = 1024;
+
+    Configuration _config;
+    std::shared_ptr<const Topology> _topology;
+
+    std::vector<double> _collectionRates;
+    std::vector<int> _maxFlightPlanLengths;
+
+public:
+    explicit GameContext(Configuration config);
+
+    [[nodiscard]] static std::shared_ptr<const GameContext> create(Configuration config);
+
+    [[nodiscard]] const Configuration &config() const;
+    [[nodiscard]] const Topology &topology() const;
+
+    /**
+     * Returns the fraction of the kore in its cell that a fleet with the given number of ships mines each turn.
+     */
+    [[nodiscard]] double getCollectionRate(int ships) const;
+
+    /**
+     * Returns the number of characters of the longest flight plan a fleet with the given number of ships can follow.
+     */
+    [[nodiscard]] int getMaxFlightPlanLength(int ships) const;
+
+private:
+    [[nodiscard]] static double computeCollectionRate(int ships);
+    [[nodiscard]] static int computeMaxFlightPlanLength(int ships);
+};
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <limits>
+
+#include <core/Action.h>
+#include <core/FlightPlan.h>
+#include <core/OccupancyTable.h>
+
+namespace {
+    const Direction DIRECTIONS[4] = {Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST};
+}
+
+OccupancyTable::OccupancyTable(const Board &board, int horizon)
+        : _topology(Topology::get(board.config().size)),
+          _horizon(std::min(horizon, MAX_HORIZON)),
+          _exactSteps(),
+          _fleets(),
+          _occupants(),
+          _stepOffsets(),
+          _shipyardSince(board.cells.count(), std::numeric_limits<int>::max()),
+          _contestedSince(board.cells.count(), std::numeric_limits<int>::max()) {
+    const auto &config = board.config();
+    int never = _horizon + 1;
+
+    for (const auto &player : board.players) {
+        for (const auto &fleet : board.fleetsOf(player.id)) {
+            _fleets.push_back({fleet.id, fleet.player, fleet.ships, fleet.trajectory, never, never, false});
+        }
+    }
+
+    // Launches are resolved like the board does at the start of the next turn, ids included
+    int idCounter = 1;
+    for (const auto &player : board.players) {
+        for (const auto &shipyard : board.shipyardsOf(player.id)) {
+            const auto &action = shipyard.action;
+            if (!action.has_value() || action->type != ActionType::LAUNCH || action->ships == 0
+                || action->ships > shipyard.ships) {
+                continue;
+            }
+
+            auto flightPlan = action->flightPlan;
+            flightPlan.truncate(board.context().getMaxFlightPlanLength(action->ships));
+
+            _fleets.push_back({EntityId::create(board.step + 1, idCounter++),
+                               shipyard.player,
+                               action->ships,
+                               Trajectory(shipyard.cell, action->flightPlan[0].direction, flightPlan, config.size),
+                               never,
+                               never,
+                               false});
+        }
+    }
+
+    // Owner of the shipyard in each cell, or CONTESTED once a fleet may have converted there or captured it
+    std::vector<int> owners(board.cells.count(), NO_SHIPYARD);
+    for (const auto &shipyard : board.shipyards) {
+        if (shipyard.player >= 0) {
+            owners[shipyard.cell] = shipyard.player;
+            _shipyardSince[shipyard.cell] = 0;
+        }
+    }
+
+    // Each fleet is followed with a copy of its trajectory, so stepping it costs the same as on a board
+    struct Cursor {
+        Trajectory trajectory;
+        int cell;
+    };
+
+    std::vector<Cursor> cursors;
+    cursors.reserve(_fleets.size());
+    for (const auto &fleet : _fleets) {
+        cursors.push_back({fleet.trajectory, fleet.trajectory.positionAt(0)});
+    }
+
+    struct Present {
+        int cell;
+        int fleet;
+
+        [[nodiscard]] bool operator<(const Present &other) const {
+            return cell < other.cell || (cell == other.cell && fleet < other.fleet);
+        }
+    };
+
+    std::vector<Present> present;
+
+    // Players with a fleet in each cell as a bit mask, cleared again after every step
+    std::vector<int> playerMasks(board.cells.count(), 0);
+
+    auto markUncertain = [&](TrackedFleet &fleet, int step) {
+        fleet.uncertainFrom = std::min(fleet.uncertainFrom, step);
+    };
+
+    auto markContested = [&](int cell, int step) {
+        owners[cell] = CONTESTED;
+        _contestedSince[cell] = std::min(_contestedSince[cell], step);
+    };
+
+    _occupants.reserve(_fleets.size() * _horizon);
+    _stepOffsets.reserve(_horizon + 1);
+    _stepOffsets.push_back(0);
+
+    for (int step = 1; step <= _horizon; step++) {
+        present.clear();
+
+        for (int i = 0, iMax = _fleets.size(); i < iMax; i++) {
+            auto &fleet = _fleets[i];
+            if (step > fleet.leavesAt) {
+                continue;
+            }
+
+            auto &cursor = cursors[i];
+
+            if (cursor.trajectory.convertsNext()) {
+                int owner = owners[cursor.cell];
+
+                if (step < fleet.uncertainFrom && owner == NO_SHIPYARD) {
+                    if (fleet.ships >= config.convertCost) {
+                        fleet.leavesAt = step;
+                        owners[cursor.cell] = fleet.player;
+                        _shipyardSince[cursor.cell] = step;
+                        continue;
+                    }
+                } else if (owner == NO_SHIPYARD || owner == CONTESTED) {
+                    markUncertain(fleet, step);
+                    markContested(cursor.cell, step);
+                }
+            }
+
+            cursor.cell = _topology->neighbor(cursor.cell, cursor.trajectory.advance());
+            present.push_back({cursor.cell, i});
+        }
+
+        std::sort(present.begin(), present.end());
+
+        // Fleets that share a cell merge or fight, and fleets in a shipyard dock or attack it
+        for (auto it = present.begin(); it != present.end();) {
+            auto groupEnd = it;
+            while (groupEnd != present.end() && groupEnd->cell == it->cell) {
+                groupEnd++;
+            }
+
+            int owner = owners[it->cell];
+
+            for (auto member = it; member != groupEnd; member++) {
+                auto &fleet = _fleets[member->fleet];
+
+                if (groupEnd - it > 1) {
+                    markUncertain(fleet, step);
+                }
+
+                if (owner == NO_SHIPYARD) {
+                    continue;
+                }
+
+                if (owner == fleet.player && groupEnd - it == 1 && step < fleet.uncertainFrom) {
+                    fleet.leavesAt = step;
+                    fleet.docks = true;
+                } else if (owner != fleet.player) {
+                    markUncertain(fleet, step);
+                    markContested(it->cell, step);
+                }
+            }
+
+            it = groupEnd;
+        }
+
+        for (const auto &[cell, fleetIndex] : present) {
+            if (_fleets[fleetIndex].leavesAt != step) {
+                playerMasks[cell] |= 1 << _fleets[fleetIndex].player;
+            }
+        }
+
+        // Fleets next to a fleet of another player damage each other
+        for (const auto &[cell, fleetIndex] : present) {
+            auto &fleet = _fleets[fleetIndex];
+            if (fleet.leavesAt == step) {
+                continue;
+            }
+
+            for (auto direction : DIRECTIONS) {
+                if ((playerMasks[_topology->neighbor(cell, direction)] & ~(1 << fleet.player)) != 0) {
+                    markUncertain(fleet, step);
+                }
+            }
+        }
+
+        for (const auto &[cell, fleetIndex] : present) {
+            const auto &fleet = _fleets[fleetIndex];
+            playerMasks[cell] = 0;
+
+            if (fleet.leavesAt != step) {
+                _occupants.push_back({cell, fleetIndex, step < fleet.uncertainFrom});
+            }
+        }
+
+        _stepOffsets.push_back(_occupants.size());
+    }
+
+    _exactSteps = _horizon;
+    for (const auto &fleet : _fleets) {
+        _exactSteps = std::min(_exactSteps, fleet.uncertainFrom - 1);
+    }
+}
+
+int OccupancyTable::getHorizon() const {
+    return _horizon;
+}
+
+int OccupancyTable::getExactSteps() const {
+    return _exactSteps;
+}
+
+const OccupancyTable::TrackedFleet &OccupancyTable::getFleet(int index) const {
+    return _fleets[index];
+}
+
+const OccupancyTable::TrackedFleet *OccupancyTable::findFleet(EntityId id) const {
+    for (const auto &fleet : _fleets) {
+        if (fleet.id == id) {
+            return &fleet;
+        }
+    }
+
+    return nullptr;
+}
+
+OccupancyTable::Occupants OccupancyTable::at(int step) const {
+    return {_occupants.data() + _stepOffsets[step - 1], _occupants.data() + _stepOffsets[step]};
+}
+
+OccupancyTable::Occupants OccupancyTable::at(int step, int cell) const {
+    auto occupants = at(step);
+
+    auto [begin, end] = std::equal_range(occupants.begin(), occupants.end(), Occupant{cell, 0, false},
+                                         [](const Occupant &a, const Occupant &b) {
+                                             return a.cell < b.cell;
+                                         });
+
+    return {begin, end};
+}
+
+bool OccupancyTable::isCertain(int step, int cell) const {
+    if (step >= _contestedSince[cell]) {
+        return false;
+    }
+
+    for (const auto &occupant : at(step, cell)) {
+        if (!occupant.certain) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool OccupancyTable::hasShipyard(int step, int cell) const {
+    return _shipyardSince[cell] <= step;
+}
+
+bool OccupancyTable::isAdjacentToOpponent(int step, int cell, int player) const {
+    for (auto direction : DIRECTIONS) {
+        for (const auto &occupant : at(step, _topology->neighbor(cell, direction))) {
+            if (_fleets[occupant.fleet].player != player) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int OccupancyTable::getArrivalStep(EntityId fleet, int cell) const {
+    const auto *trackedFleet = findFleet(fleet);
+    if (trackedFleet == nullptr) {
+        return NEVER;
+    }
+
+    for (int step = 1; step <= _horizon; step++) {
+        if (step >= trackedFleet->uncertainFrom) {
+            return UNKNOWN;
+        }
+
+        if (step == trackedFleet->leavesAt) {
+            return trackedFleet->docks && trackedFleet->trajectory.positionAt(step) == cell ? step : NEVER;
+        }
+
+        if (trackedFleet->trajectory.positionAt(step) == cell) {
+            return step;
+        }
+    }
+
+    return NEVER;
+}
+
+int OccupancyTable::getInterceptStep(EntityId fleet, int cell) const {
+    const auto *trackedFleet = findFleet(fleet);
+    if (trackedFleet == nullptr) {
+        return NEVER;
+    }
+
+    for (int step = 1; step <= _horizon; step++) {
+        if (step >= trackedFleet->uncertainFrom) {
+            return UNKNOWN;
+        }
+
+        if (step == trackedFleet->leavesAt) {
+            return NEVER;
+        }
+
+        if (_topology->distance(cell, trackedFleet->trajectory.positionAt(step)) <= step) {
+            return step;
+        }
+    }
+
+    return NEVER;
+}
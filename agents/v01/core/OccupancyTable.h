@@ -0,0 +1,144 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <core/Board.h>
+#include <core/EntityId.h>
+#include <core/Topology.h>
+#include <core/Trajectory.h>
+
+/**
+ * The cells the fleets of a board occupy over the next turns if nobody sets further actions, indexed by step and cell.
+ * Fleets never leave their trajectory, they only disappear by docking, converting, merging or losing a fight, so the
+ * table follows every fleet, including those launched by the actions set on the board, until it may interact with
+ * another fleet or with a shipyard it does not own. From then on its entries are only possible ones, and queries
+ * that depend on them report that the board has to be simulated instead.
+ *
+ * Within the exact steps the table agrees with the boards a simulation produces: the fleets, their cells and ships,
+ * and the cells that have a shipyard.
+ */
+class OccupancyTable {
+public:
+    static constexpr int MAX_HORIZON = 50;
+
+    /**
+     * Returned by queries when the fleet is known not to get there within the horizon.
+     */
+    static constexpr int NEVER = -1;
+
+    /**
+     * Returned by queries when the answer depends on an interaction, which only a simulation resolves.
+     */
+    static constexpr int UNKNOWN = -2;
+
+    struct TrackedFleet {
+        EntityId id;
+        int player;
+        int ships;
+        Trajectory trajectory;
+
+        // First step whose outcome depends on an interaction, past the horizon if there is none
+        int uncertainFrom;
+
+        // Step at which the fleet is known to dock or convert, past the horizon if it does not
+        int leavesAt;
+        bool docks;
+    };
+
+    struct Occupant {
+        int cell;
+        int fleet;
+        bool certain;
+    };
+
+    class Occupants {
+        const Occupant *_begin;
+        const Occupant *_end;
+
+    public:
+        Occupants(const Occupant *begin, const Occupant *end) : _begin(begin), _end(end) {}
+
+        [[nodiscard]] const Occupant *begin() const {
+            return _begin;
+        }
+
+        [[nodiscard]] const Occupant *end() const {
+            return _end;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return _begin == _end;
+        }
+    };
+
+private:
+    static constexpr int NO_SHIPYARD = -1;
+    static constexpr int CONTESTED = -2;
+
+    std::shared_ptr<const Topology> _topology;
+    int _horizon;
+    int _exactSteps;
+
+    std::vector<TrackedFleet> _fleets;
+
+    // Occupants of each step sorted by cell, the ones of step s start at _stepOffsets[s - 1]
+    std::vector<Occupant> _occupants;
+    std::vector<int> _stepOffsets;
+
+    // First step at which each cell is known to have a shipyard, and from which a fleet may have converted there or
+    // captured it
+    std::vector<int> _shipyardSince;
+    std::vector<int> _contestedSince;
+
+public:
+    OccupancyTable(const Board &board, int horizon);
+
+    [[nodiscard]] int getHorizon() const;
+
+    /**
+     * Returns the number of steps ahead up to which no fleet may have interacted, so every entry is certain.
+     */
+    [[nodiscard]] int getExactSteps() const;
+
+    [[nodiscard]] const TrackedFleet &getFleet(int index) const;
+    [[nodiscard]] const TrackedFleet *findFleet(EntityId id) const;
+
+    /**
+     * Returns the fleets that may be in any cell at the end of the given step, with 1 being the next turn.
+     */
+    [[nodiscard]] Occupants at(int step) const;
+
+    /**
+     * Returns the fleets that may be in the cell at the end of the given step, with 1 being the next turn.
+     */
+    [[nodiscard]] Occupants at(int step, int cell) const;
+
+    /**
+     * Returns whether the fleets and the shipyard in the cell at the end of the given step are known. A cell without
+     * any occupant is known to be free of fleets even after the exact steps.
+     */
+    [[nodiscard]] bool isCertain(int step, int cell) const;
+
+    /**
+     * Returns whether the cell has a shipyard at the end of the given step, which is only known while it is certain.
+     */
+    [[nodiscard]] bool hasShipyard(int step, int cell) const;
+
+    /**
+     * Returns whether a fleet of another player than the given one may be next to the cell at the end of the step.
+     * The answer is exact within the exact steps, later ones include every fleet that may still exist.
+     */
+    [[nodiscard]] bool isAdjacentToOpponent(int step, int cell, int player) const;
+
+    /**
+     * Returns the first step at which the fleet enters the cell, docking included, NEVER or UNKNOWN.
+     */
+    [[nodiscard]] int getArrivalStep(EntityId fleet, int cell) const;
+
+    /**
+     * Returns the first step at which the fleet is within as many steps of the cell as have passed, so a fleet
+     * launched from the cell now could meet it there, NEVER or UNKNOWN.
+     */
+    [[nodiscard]] int getInterceptStep(EntityId fleet, int cell) const;
+};
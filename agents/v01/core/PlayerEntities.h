@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+template<typename Container>
+class PlayerEntities {
+    using Entity = std::conditional_t<std::is_const_v<Container>,
+                                      const typename Container::value_type,
+                                      typename Container::value_type>;
+
+    Container *_entities;
+    int _player;
+
+public:
+    class Iterator {
+        Container *_entities;
+        std::size_t _index;
+        int _player;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entity;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Entity *;
+        using reference = Entity &;
+
+        Iterator(Container *entities, std::size_t index, int player)
+                : _entities(entities), _index(index), _player(player) {
+            skipOtherPlayers();
+        }
+
+        [[nodiscard]] Entity &operator*() const {
+            return (*_entities)[_index];
+        }
+
+        [[nodiscard]] Entity *operator->() const {
+            return &(*_entities)[_index];
+        }
+
+        Iterator &operator++() {
+            _index++;
+            skipOtherPlayers();
+            return *this;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator &other) const {
+            // Any iterator past the current size equals end(), so appending entities while iterating is safe
+            if (atEnd() || other.atEnd()) {
+                return atEnd() == other.atEnd();
+            }
+
+            return _index == other._index;
+        }
+
+        [[nodiscard]] bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        [[nodiscard]] bool atEnd() const {
+            return _index >= _entities->size();
+        }
+
+        void skipOtherPlayers() {
+            while (_index < _entities->size() && (*_entities)[_index].player != _player) {
+                _index++;
+            }
+        }
+    };
+
+    PlayerEntities(Container &entities, int player) : _entities(&entities), _player(player) {}
+
+    [[nodiscard]] Iterator begin() const {
+        return {_entities, 0, _player};
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return {_entities, _entities->size(), _player};
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::size_t count = 0;
+        for (const auto &entity : *_entities) {
+            if (entity.player == _player) {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return begin() == end();
+    }
+};
@@ -1,4 +1,3 @@
-#include <core/Player.h>
 #include <core/Shipyard.h>
 
 int Shipyard::getSpawnMaximum() const {
@@ -24,8 +23,3 @@ int Shipyard::getSpawnMaximum() const {
         return 10;
     }
 }
-
-void Shipyard::remove() const {
-    cell->shipyard = nullptr;
-    player->removeShipyard(this);
-}
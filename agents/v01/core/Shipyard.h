@@ -1,22 +1,17 @@
 #pragma once
 
 #include <optional>
-#include <string>
 
 #include <core/Action.h>
-#include <core/Cell.h>
-
-class Player;
+#include <core/EntityId.h>
 
 struct Shipyard {
-    std::string id;
-    Cell *cell;
-    Player *player;
+    EntityId id;
+    int cell;
+    int player;
     int ships;
     int turnsControlled;
     std::optional<Action> action;
 
     [[nodiscard]] int getSpawnMaximum() const;
-
-    void remove() const;
 };
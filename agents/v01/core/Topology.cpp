@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+#include <core/Topology.h>
+
+Topology::CellRange::CellRange(const int *begin, const int *end) : _begin(begin), _end(end) {}
+
+const int *Topology::CellRange::begin() const {
+    return _begin;
+}
+
+const int *Topology::CellRange::end() const {
+    return _end;
+}
+
+std::size_t Topology::CellRange::size() const {
+    return _end - _begin;
+}
+
+Topology::Topology(int size)
+        : _size(size),
+          _maxDistance(2 * (size / 2)),
+          _distances(size * size * size * size),
+          _neighbors(size * size),
+          _cellsByDistance(size * size * size * size),
+          _radiusEnds(size * size * (_maxDistance + 1)) {
+    int cellCount = size * size;
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            auto &cellNeighbors = _neighbors[cellToIndex(x, y)];
+            cellNeighbors[static_cast<int>(Direction::NORTH)] = cellToIndex(x, y + 1);
+            cellNeighbors[static_cast<int>(Direction::EAST)] = cellToIndex(x + 1, y);
+            cellNeighbors[static_cast<int>(Direction::SOUTH)] = cellToIndex(x, y - 1);
+            cellNeighbors[static_cast<int>(Direction::WEST)] = cellToIndex(x - 1, y);
+        }
+    }
+
+    for (int from = 0; from < cellCount; from++) {
+        int fromX = from % size;
+        int fromY = size - 1 - from / size;
+
+        for (int to = 0; to < cellCount; to++) {
+            int dx = std::abs(to % size - fromX);
+            int dy = std::abs(size - 1 - to / size - fromY);
+
+            _distances[from * cellCount + to] = std::min(dx, size - dx) + std::min(dy, size - dy);
+        }
+
+        auto cellsBegin = _cellsByDistance.begin() + from * cellCount;
+        for (int to = 0; to < cellCount; to++) {
+            cellsBegin[to] = to;
+        }
+
+        std::stable_sort(cellsBegin, cellsBegin + cellCount, [&](int a, int b) {
+            return distance(from, a) < distance(from, b);
+        });
+
+        int end = 0;
+        for (int radius = 0; radius <= _maxDistance; radius++) {
+            while (end < cellCount && distance(from, cellsBegin[end]) <= radius) {
+                end++;
+            }
+
+            _radiusEnds[from * (_maxDistance + 1) + radius] = end;
+        }
+    }
+}
+
+std::shared_ptr<const Topology> Topology::get(int size) {
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const Topology>> topologies;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &topology = topologies[size];
+    if (topology == nullptr) {
+        topology = std::make_shared<const Topology>(size);
+    }
+
+    return topology;
+}
+
+int Topology::getSize() const {
+    return _size;
+}
+
+int Topology::getCellCount() const {
+    return _size * _size;
+}
+
+int Topology::getMaxDistance() const {
+    return _maxDistance;
+}
+
+int Topology::cellToIndex(int x, int y) const {
+    x = (x % _size + _size) % _size;
+    y = (y % _size + _size) % _size;
+
+    return (_size - y - 1) * _size + x;
+}
+
+int Topology::distance(int from, int to) const {
+    return _distances[from * getCellCount() + to];
+}
+
+int Topology::neighbor(int index, Direction direction) const {
+    return _neighbors[index][static_cast<int>(direction)];
+}
+
+Topology::CellRange Topology::cellsWithin(int index, int radius) const {
+    const int *begin = _cellsByDistance.data() + index * getCellCount();
+    if (radius < 0) {
+        return {begin, begin};
+    }
+
+    int end = _radiusEnds[index * (_maxDistance + 1) + std::min(radius, _maxDistance)];
+    return {begin, begin + end};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <core/Direction.h>
+
+/**
+ * Distances, neighbors and radius queries on the wrapping board of one size. Instances are immutable, built once per
+ * size on first use and shared by every board of that size.
+ */
+class Topology {
+public:
+    class CellRange {
+        const int *_begin;
+        const int *_end;
+
+    public:
+        CellRange(const int *begin, const int *end);
+
+        [[nodiscard]] const int *begin() const;
+        [[nodiscard]] const int *end() const;
+
+        [[nodiscard]] std::size_t size() const;
+    };
+
+private:
+    int _size;
+    int _maxDistance;
+
+    std::vector<std::uint8_t> _distances;
+    std::vector<std::array<int, 4>> _neighbors;
+
+    std::vector<int> _cellsByDistance;
+    std::vector<int> _radiusEnds;
+
+public:
+    explicit Topology(int size);
+
+    [[nodiscard]] static std::shared_ptr<const Topology> get(int size);
+
+    [[nodiscard]] int getSize() const;
+    [[nodiscard]] int getCellCount() const;
+    [[nodiscard]] int getMaxDistance() const;
+
+    [[nodiscard]] int cellToIndex(int x, int y) const;
+
+    /**
+     * Returns the Manhattan distance between two cells, taking the wraparound of the board into account.
+     */
+    [[nodiscard]] int distance(int from, int to) const;
+
+    [[nodiscard]] int neighbor(int index, Direction direction) const;
+
+    /**
+     * Returns the cells within the given distance of a cell ordered by distance, starting with the cell itself.
+     */
+    [[nodiscard]] CellRange cellsWithin(int index, int radius) const;
+};
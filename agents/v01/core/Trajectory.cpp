@@ -0,0 +1,127 @@
+#include <algorithm>
+
+#include <core/Trajectory.h>
+
+namespace {
+    const int DELTA_X[4] = {0, 1, 0, -1};
+    const int DELTA_Y[4] = {1, 0, -1, 0};
+}
+
+Trajectory::Trajectory(int cell, Direction direction, const FlightPlan &flightPlan, int size)
+        : _legs(), _legCount(0), _size(size), _step(0), _leg(0) {
+    int x = cell % size;
+    int y = size - 1 - cell / size;
+    int step = 0;
+
+    auto addLeg = [&](bool converts) {
+        if (_legCount > 0 && !converts && _legs[_legCount - 1].direction == direction) {
+            return;
+        }
+
+        // Legs past the longest move start at the same step, which no game reaches
+        _legs[_legCount++] = {static_cast<std::uint16_t>(std::min(step + 1, FlightPlanPart::MAX_STEPS)),
+                              static_cast<std::int8_t>(x),
+                              static_cast<std::int8_t>(y),
+                              direction,
+                              converts};
+    };
+
+    // Mirrors how the game consumes a plan one step at a time, with each move part taken in one go
+    std::size_t i = 0;
+    std::size_t partCount = flightPlan.size();
+    bool converts = false;
+
+    while (true) {
+        while (i < partCount
+               && flightPlan[i].type == FlightPlanPartType::MOVE
+               && flightPlan[i].steps == 0) {
+            i++;
+        }
+
+        converts = i < partCount && flightPlan[i].type == FlightPlanPartType::CONVERT;
+        while (i < partCount && flightPlan[i].type == FlightPlanPartType::CONVERT) {
+            i++;
+        }
+
+        if (i == partCount) {
+            break;
+        }
+
+        int steps = 1;
+        if (flightPlan[i].type == FlightPlanPartType::TURN) {
+            direction = flightPlan[i].direction;
+        } else if (flightPlan[i].steps > 1) {
+            steps = flightPlan[i].steps;
+        }
+
+        i++;
+
+        addLeg(converts);
+
+        x = wrap(x + DELTA_X[static_cast<int>(direction)] * steps);
+        y = wrap(y + DELTA_Y[static_cast<int>(direction)] * steps);
+        step += steps;
+    }
+
+    // Once the plan runs out the fleet keeps flying in its last direction
+    addLeg(converts);
+}
+
+int Trajectory::getSteps() const {
+    return _step;
+}
+
+bool Trajectory::convertsNext() const {
+    const auto &leg = _legs[_leg];
+    return leg.converts && leg.firstStep == _step + 1;
+}
+
+Direction Trajectory::advance() {
+    Direction direction = _legs[_leg].direction;
+
+    _step++;
+    if (_leg + 1 < _legCount && _legs[_leg + 1].firstStep == _step + 1) {
+        _leg++;
+    }
+
+    return direction;
+}
+
+int Trajectory::positionAt(int steps) const {
+    int step = _step + steps;
+    if (step == 0) {
+        const auto &leg = _legs[0];
+        return (_size - 1 - leg.y) * _size + leg.x;
+    }
+
+    const auto &leg = legAt(step);
+    int distance = step - leg.firstStep + 1;
+
+    int x = wrap(leg.x + DELTA_X[static_cast<int>(leg.direction)] * distance);
+    int y = wrap(leg.y + DELTA_Y[static_cast<int>(leg.direction)] * distance);
+
+    return (_size - 1 - y) * _size + x;
+}
+
+int Trajectory::stepsUntilConvert() const {
+    for (int i = _leg; i < _legCount; i++) {
+        if (_legs[i].converts && _legs[i].firstStep > _step) {
+            return _legs[i].firstStep - 1 - _step;
+        }
+    }
+
+    return -1;
+}
+
+const Trajectory::Leg &Trajectory::legAt(int step) const {
+    int leg = _step < step ? _leg : 0;
+    while (leg + 1 < _legCount && _legs[leg + 1].firstStep <= step) {
+        leg++;
+    }
+
+    return _legs[leg];
+}
+
+int Trajectory::wrap(int value) const {
+    return (value % _size + _size) % _size;
+}
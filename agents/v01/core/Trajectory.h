@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <core/Direction.h>
+#include <core/FlightPlan.h>
+
+/**
+ * The path a fleet takes by following its flight plan, computed once when the fleet enters the board. The path is
+ * stored as legs, straight runs in one direction that start where the plan turns or tries to convert, so following
+ * it takes one cursor increment per step and the position any number of steps ahead is a lookup in its legs.
+ *
+ * Whether a fleet converts depends on the board, so the trajectory only marks the steps at which the plan tries to.
+ * A fleet that fails to convert keeps following the same path.
+ */
+class Trajectory {
+public:
+    static constexpr std::size_t CAPACITY = FlightPlan::CAPACITY + 1;
+
+private:
+    struct Leg {
+        std::uint16_t firstStep;
+        std::int8_t x;
+        std::int8_t y;
+        Direction direction;
+        bool converts;
+    };
+
+    std::array<Leg, CAPACITY> _legs;
+    std::uint8_t _legCount;
+    std::uint8_t _size;
+
+    // Steps taken since the fleet entered the board, and the leg containing the next step
+    std::uint16_t _step;
+    std::uint8_t _leg;
+
+public:
+    Trajectory() : _legs(), _legCount(0), _size(0), _step(0), _leg(0) {}
+
+    Trajectory(int cell, Direction direction, const FlightPlan &flightPlan, int size);
+
+    [[nodiscard]] int getSteps() const;
+
+    /**
+     * Returns whether the flight plan tries to convert at the start of the next step.
+     */
+    [[nodiscard]] bool convertsNext() const;
+
+    /**
+     * Moves the cursor by one step and returns the direction of that step.
+     */
+    Direction advance();
+
+    /**
+     * Returns the cell of the fleet after the given number of further steps, with 0 being its current cell.
+     */
+    [[nodiscard]] int positionAt(int steps) const;
+
+    /**
+     * Returns the number of further steps after which the plan next tries to convert, or -1 if it never does.
+     */
+    [[nodiscard]] int stepsUntilConvert() const;
+
+private:
+    [[nodiscard]] const Leg &legAt(int step) const;
+
+    [[nodiscard]] int wrap(int value) const;
+};
+
+static_assert(std::is_trivially_copyable_v<Trajectory>, "Trajectories are copied with every fleet");
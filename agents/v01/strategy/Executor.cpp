@@ -0,0 +1,173 @@
+#include <strategy/Executor.h>
+
+namespace {
+    // Threads that do not belong to the executor share the first queue
+    thread_local int currentQueue = 0;
+}
+
+Executor::Executor(int threadCount) : _queuedTasks(0), _stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+
+    for (int i = 1; i < threadCount; i++) {
+        _threads.emplace_back(&Executor::workerLoop, this, i);
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _workAvailable.notify_all();
+
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+int Executor::getThreadCount() const {
+    return (int) _queues.size();
+}
+
+void Executor::forEach(int count, const std::function<void(int)> &task) {
+    if (count <= 0) {
+        return;
+    }
+
+    std::exception_ptr error;
+
+    if (_threads.empty() || count == 1) {
+        for (int i = 0; i < count; i++) {
+            try {
+                task(i);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        return;
+    }
+
+    int queue = currentQueue;
+
+    // Guarded by the mutex, which the last task still holds while it notifies, so the state outlives every task
+    std::mutex mutex;
+    std::condition_variable finished;
+    int remaining = count;
+
+    {
+        auto &ownQueue = *_queues[queue];
+        std::lock_guard<std::mutex> lock(ownQueue.mutex);
+
+        // The owner takes tasks from the back, so pushing in reverse runs them in index order on this thread
+        for (int i = count - 1; i >= 0; i--) {
+            ownQueue.tasks.emplace_back([&, i]() {
+                std::exception_ptr taskError;
+                try {
+                    task(i);
+                } catch (...) {
+                    taskError = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (taskError && !error) {
+                    error = taskError;
+                }
+
+                if (--remaining == 0) {
+                    finished.notify_all();
+                }
+            });
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queuedTasks += count;
+    }
+
+    _workAvailable.notify_all();
+
+    // Once no queue has a task left, every remaining task of this call is already running on another thread
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (remaining == 0) {
+                break;
+            }
+        }
+
+        if (!runTask(queue)) {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&]() { return remaining == 0; });
+            break;
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool Executor::runTask(int queue) {
+    std::function<void()> task;
+
+    {
+        auto &ownQueue = *_queues[queue];
+        std::lock_guard<std::mutex> lock(ownQueue.mutex);
+
+        if (!ownQueue.tasks.empty()) {
+            task = std::move(ownQueue.tasks.back());
+            ownQueue.tasks.pop_back();
+        }
+    }
+
+    for (int i = 1; !task && i < (int) _queues.size(); i++) {
+        auto &otherQueue = *_queues[(queue + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(otherQueue.mutex);
+
+        if (!otherQueue.tasks.empty()) {
+            task = std::move(otherQueue.tasks.front());
+            otherQueue.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    _queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    task();
+
+    return true;
+}
+
+void Executor::workerLoop(int queue) {
+    currentQueue = queue;
+
+    while (true) {
+        if (runTask(queue)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _workAvailable.wait(lock, [&]() { return _stopping || _queuedTasks > 0; });
+
+        if (_stopping) {
+            return;
+        }
+    }
+}
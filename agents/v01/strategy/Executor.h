@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A work-stealing executor with one task queue per thread. Threads run tasks from the back of their own queue and
+ * steal from the front of the others. A thread waiting for its tasks keeps running queued tasks, so tasks can submit
+ * and wait for tasks of their own.
+ */
+class Executor {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::atomic<int> _queuedTasks;
+    bool _stopping;
+
+public:
+    /**
+     * A thread count of 0 uses one thread per hardware thread. The thread calling into the executor counts as one of
+     * them.
+     */
+    explicit Executor(int threadCount = 0);
+    ~Executor();
+
+    Executor(const Executor &other) = delete;
+    Executor &operator=(const Executor &other) = delete;
+
+    [[nodiscard]] int getThreadCount() const;
+
+    /**
+     * Runs task(i) for every i in [0, count) and returns when all of them have finished. If tasks throw, the others
+     * still run and the first exception is rethrown on the calling thread.
+     */
+    void forEach(int count, const std::function<void(int)> &task);
+
+    /**
+     * Runs task(i) for every i in [0, count) and returns the results in index order.
+     */
+    template<typename Task>
+    auto map(int count, Task task) -> std::vector<decltype(task(0))> {
+        std::vector<decltype(task(0))> results(count);
+        forEach(count, [&](int i) {
+            results[i] = task(i);
+        });
+
+        return results;
+    }
+
+    /**
+     * Returns the lowest i in [0, count) for which predicate(i) is true, or -1 if there is none.
+     * Candidates are evaluated in batches of getThreadCount(), so a single thread evaluates exactly the candidates a
+     * serial search would.
+     */
+    template<typename Predicate>
+    int findFirst(int count, Predicate predicate) {
+        int batchSize = getThreadCount();
+        std::vector<char> matches(batchSize);
+
+        for (int begin = 0; begin < count; begin += batchSize) {
+            int size = std::min(batchSize, count - begin);
+            forEach(size, [&](int i) {
+                matches[i] = predicate(begin + i);
+            });
+
+            for (int i = 0; i < size; i++) {
+                if (matches[i]) {
+                    return begin + i;
+                }
+            }
+        }
+
+        return -1;
+    }
+
+private:
+    bool runTask(int queue);
+
+    void workerLoop(int queue);
+};
@@ -1,118 +1,58 @@
+#include <algorithm>
 #include <cmath>
-#include <fstream>
-#include <utility>
 
 #include <strategy/FlightPlanDatabase.h>
 
-FlightPlanDatabase::FlightPlanDatabase(const Configuration &config) : _boardSize(config.size) {
-    loadPlans(config.agentDirectory / "data" / "target-plans.txt", _targetPlansByIndex, _targetPlansByIndexBySteps);
-    loadPlans(config.agentDirectory / "data" / "convert-plans.txt", _convertPlansByIndex, _convertPlansByIndexBySteps);
-}
-
-std::vector<std::string> FlightPlanDatabase::getTargetPlans(const Cell &from, const Cell &to, int ships) const {
-    return getPlans(from, to, ships, _targetPlansByIndex);
-}
+FlightPlanDatabase::FlightPlanDatabase(const Configuration &config)
+        : _boardSize(config.size),
+          _topology(Topology::get(config.size)),
+          _targetPlans(FlightPlanTable::load(config.agentDirectory / "data" / "target-plans.txt", config.size)),
+          _convertPlans(FlightPlanTable::load(config.agentDirectory / "data" / "convert-plans.txt", config.size)) {}
 
-std::vector<std::string> FlightPlanDatabase::getTargetPlans(const Cell &from,
-                                                            const Cell &to,
-                                                            int ships,
-                                                            int steps) const {
-    return getPlans(from, to, ships, steps, _targetPlansByIndexBySteps);
+FlightPlanTable::PlanList FlightPlanDatabase::getTargetPlans(const Cell &from, const Cell &to, int ships) const {
+    return getPlans(from, to, ships, _targetPlans);
 }
 
-std::vector<std::string> FlightPlanDatabase::getConvertPlans(const Cell &from, const Cell &to, int ships) const {
-    return getPlans(from, to, ships, _convertPlansByIndex);
-}
-
-std::vector<std::string> FlightPlanDatabase::getConvertPlans(const Cell &from,
+FlightPlanTable::PlanList FlightPlanDatabase::getTargetPlans(const Cell &from,
                                                              const Cell &to,
                                                              int ships,
                                                              int steps) const {
-    return getPlans(from, to, ships, steps, _convertPlansByIndexBySteps);
+    return getPlans(from, to, ships, steps, _targetPlans);
 }
 
-void FlightPlanDatabase::loadPlans(const std::filesystem::path &file,
-                                   std::vector<std::vector<std::string>> &plansByIndex,
-                                   std::vector<std::unordered_map<int, std::vector<std::string>>> &plansByIndexBySteps) {
-    plansByIndex.resize(_boardSize * _boardSize);
-    plansByIndexBySteps.resize(_boardSize * _boardSize);
-
-    std::ifstream stream(file);
-
-    int chunkCount;
-    stream >> chunkCount;
-
-    for (int i = 0; i < chunkCount; i++) {
-        int dx, dy, stepsOptions, uniquePlanCount;
-        stream >> dx >> dy >> stepsOptions >> uniquePlanCount;
-
-        int index = getIndex(dx, dy);
-        auto &uniquePlans = plansByIndex[index];
-        auto &plansByStepsMap = plansByIndexBySteps[index];
-
-        uniquePlans.reserve(uniquePlanCount);
-
-        for (int j = 0; j < stepsOptions; j++) {
-            int steps, planCount;
-            stream >> steps >> planCount;
-
-            auto &plansByStepsVec = plansByStepsMap[steps];
-            plansByStepsVec.reserve(planCount);
-
-            for (int k = 0; k < planCount; k++) {
-                bool isFirst;
-                std::string plan;
-                stream >> isFirst >> plan;
-
-                if (isFirst) {
-                    uniquePlans.push_back(plan);
-                }
-
-                plansByStepsVec.push_back(std::move(plan));
-            }
-        }
-    }
+FlightPlanTable::PlanList FlightPlanDatabase::getConvertPlans(const Cell &from, const Cell &to, int ships) const {
+    return getPlans(from, to, ships, _convertPlans);
 }
 
-std::vector<std::string> FlightPlanDatabase::getPlans(const Cell &from,
-                                                      const Cell &to,
-                                                      int ships,
-                                                      const std::vector<std::vector<std::string>> &plansByIndex) const {
-    return filterPlans(plansByIndex[getIndex(from, to)], ships);
+FlightPlanTable::PlanList FlightPlanDatabase::getConvertPlans(const Cell &from,
+                                                              const Cell &to,
+                                                              int ships,
+                                                              int steps) const {
+    return getPlans(from, to, ships, steps, _convertPlans);
 }
 
-std::vector<std::string> FlightPlanDatabase::getPlans(const Cell &from,
-                                                      const Cell &to,
-                                                      int ships,
-                                                      int steps,
-                                                      const std::vector<std::unordered_map<int, std::vector<std::string>>> &plansByIndexBySteps) const {
-    if (from.distanceTo(to) > steps) {
-        return {};
-    }
-
-    const auto &plansBySteps = plansByIndexBySteps[getIndex(from, to)];
-    const auto &plans = plansBySteps.find(steps);
+FlightPlanTable::PlanList FlightPlanDatabase::getPlans(const Cell &from,
+                                                       const Cell &to,
+                                                       int ships,
+                                                       const FlightPlanTable &table) const {
+    return filterPlans(table.getPlans(getIndex(from, to)), ships);
+}
 
-    if (plans == plansBySteps.end()) {
+FlightPlanTable::PlanList FlightPlanDatabase::getPlans(const Cell &from,
+                                                       const Cell &to,
+                                                       int ships,
+                                                       int steps,
+                                                       const FlightPlanTable &table) const {
+    if (_topology->distance(from.index, to.index) > steps) {
         return {};
     }
 
-    return filterPlans(plans->second, ships);
+    return filterPlans(table.getPlans(getIndex(from, to), steps), ships);
 }
 
-std::vector<std::string> FlightPlanDatabase::filterPlans(const std::vector<std::string> &allPlans, int ships) const {
+FlightPlanTable::PlanList FlightPlanDatabase::filterPlans(const FlightPlanTable::PlanList &allPlans, int ships) const {
     int maxLength = std::floor(2.0 * std::log(ships)) + 1;
-
-    std::vector<std::string> plans;
-    plans.reserve(allPlans.size());
-
-    for (const auto &plan : allPlans) {
-        if (plan.size() <= maxLength) {
-            plans.push_back(plan);
-        }
-    }
-
-    return plans;
+    return allPlans.withMaxLength(std::max(maxLength, 0));
 }
 
 int FlightPlanDatabase::getIndex(int dx, int dy) const {
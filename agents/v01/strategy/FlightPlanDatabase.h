@@ -1,54 +1,50 @@
 #pragma once
 
-#include <filesystem>
-#include <string>
-#include <unordered_map>
-#include <vector>
+#include <memory>
 
 #include <core/Cell.h>
 #include <core/Configuration.h>
+#include <core/Topology.h>
+#include <strategy/FlightPlanTable.h>
 
+/**
+ * Plan lookups return views into the database, which remain valid as long as the database does.
+ */
 class FlightPlanDatabase {
     int _boardSize;
+    std::shared_ptr<const Topology> _topology;
 
-    std::vector<std::vector<std::string>> _targetPlansByIndex;
-    std::vector<std::unordered_map<int, std::vector<std::string>>> _targetPlansByIndexBySteps;
-
-    std::vector<std::vector<std::string>> _convertPlansByIndex;
-    std::vector<std::unordered_map<int, std::vector<std::string>>> _convertPlansByIndexBySteps;
+    FlightPlanTable _targetPlans;
+    FlightPlanTable _convertPlans;
 
 public:
     explicit FlightPlanDatabase(const Configuration &config);
 
-    [[nodiscard]] std::vector<std::string> getTargetPlans(const Cell &from, const Cell &to, int ships) const;
-    [[nodiscard]] std::vector<std::string> getTargetPlans(const Cell &from,
-                                                          const Cell &to,
-                                                          int ships,
-                                                          int steps) const;
-
-    [[nodiscard]] std::vector<std::string> getConvertPlans(const Cell &from, const Cell &to, int ships) const;
-    [[nodiscard]] std::vector<std::string> getConvertPlans(const Cell &from,
+    [[nodiscard]] FlightPlanTable::PlanList getTargetPlans(const Cell &from, const Cell &to, int ships) const;
+    [[nodiscard]] FlightPlanTable::PlanList getTargetPlans(const Cell &from,
                                                            const Cell &to,
                                                            int ships,
                                                            int steps) const;
 
+    [[nodiscard]] FlightPlanTable::PlanList getConvertPlans(const Cell &from, const Cell &to, int ships) const;
+    [[nodiscard]] FlightPlanTable::PlanList getConvertPlans(const Cell &from,
+                                                            const Cell &to,
+                                                            int ships,
+                                                            int steps) const;
+
 private:
-    void loadPlans(const std::filesystem::path &file,
-                   std::vector<std::vector<std::string>> &plansByIndex,
-                   std::vector<std::unordered_map<int, std::vector<std::string>>> &plansByIndexBySteps);
-
-    [[nodiscard]] std::vector<std::string> getPlans(const Cell &from,
-                                                    const Cell &to,
-                                                    int ships,
-                                                    const std::vector<std::vector<std::string>> &plansByIndex) const;
-
-    [[nodiscard]] std::vector<std::string> getPlans(const Cell &from,
-                                                    const Cell &to,
-                                                    int ships,
-                                                    int steps,
-                                                    const std::vector<std::unordered_map<int, std::vector<std::string>>> &plansByIndexBySteps) const;
-
-    [[nodiscard]] std::vector<std::string> filterPlans(const std::vector<std::string> &allPlans, int ships) const;
+    [[nodiscard]] FlightPlanTable::PlanList getPlans(const Cell &from,
+                                                     const Cell &to,
+                                                     int ships,
+                                                     const FlightPlanTable &table) const;
+
+    [[nodiscard]] FlightPlanTable::PlanList getPlans(const Cell &from,
+                                                     const Cell &to,
+                                                     int ships,
+                                                     int steps,
+                                                     const FlightPlanTable &table) const;
+
+    [[nodiscard]] FlightPlanTable::PlanList filterPlans(const FlightPlanTable::PlanList &allPlans, int ships) const;
 
     [[nodiscard]] int getIndex(int dx, int dy) const;
     [[nodiscard]] int getIndex(const Cell &from, const Cell &to) const;
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <strategy/FlightPlanTable.h>
+
+FlightPlanTable::PlanList::Iterator::Iterator(const FlightPlanTable *table, const std::uint32_t *reference)
+        : _table(table), _reference(reference) {}
+
+EncodedFlightPlan FlightPlanTable::PlanList::Iterator::operator*() const {
+    return _table->getPlan(*_reference);
+}
+
+FlightPlanTable::PlanList::Iterator &FlightPlanTable::PlanList::Iterator::operator++() {
+    _reference++;
+    return *this;
+}
+
+bool FlightPlanTable::PlanList::Iterator::operator==(const Iterator &other) const {
+    return _reference == other._reference;
+}
+
+bool FlightPlanTable::PlanList::Iterator::operator!=(const Iterator &other) const {
+    return _reference != other._reference;
+}
+
+FlightPlanTable::PlanList::PlanList() : _table(nullptr), _begin(nullptr), _end(nullptr) {}
+
+FlightPlanTable::PlanList::PlanList(const FlightPlanTable *table,
+                                    const std::uint32_t *begin,
+                                    const std::uint32_t *end)
+        : _table(table), _begin(begin), _end(end) {}
+
+FlightPlanTable::PlanList::Iterator FlightPlanTable::PlanList::begin() const {
+    return {_table, _begin};
+}
+
+FlightPlanTable::PlanList::Iterator FlightPlanTable::PlanList::end() const {
+    return {_table, _end};
+}
+
+std::size_t FlightPlanTable::PlanList::size() const {
+    return _end - _begin;
+}
+
+bool FlightPlanTable::PlanList::empty() const {
+    return _begin == _end;
+}
+
+EncodedFlightPlan FlightPlanTable::PlanList::operator[](std::size_t index) const {
+    return _table->getPlan(_begin[index]);
+}
+
+FlightPlanTable::PlanList FlightPlanTable::PlanList::withMaxLength(std::size_t maxLength) const {
+    const auto *end = std::partition_point(_begin, _end, [&](std::uint32_t plan) {
+        return _table->getPlanLength(plan) <= maxLength;
+    });
+
+    return {_table, _begin, end};
+}
+
+FlightPlanTable::FlightPlanTable()
+        : _file(),
+          _buffer(),
+          _boardSize(0),
+          _stepsCount(0),
+          _uniqueOffsets(nullptr),
+          _stepsOffsets(nullptr),
+          _references(nullptr),
+          _partOffsets(nullptr),
+          _lengths(nullptr),
+          _parts(nullptr) {}
+
+FlightPlanTable FlightPlanTable::load(const std::filesystem::path &textFile, int boardSize) {
+    auto binaryFile = textFile;
+    binaryFile.replace_extension(".bin");
+
+    if (std::filesystem::is_regular_file(binaryFile)) {
+        // A stale binary file, written by another version of the format for example, must not abort the startup
+        try {
+            return loadBinary(binaryFile, boardSize);
+        } catch (const std::runtime_error &) {
+        }
+    }
+
+    return loadText(textFile, boardSize);
+}
+
+FlightPlanTable FlightPlanTable::loadBinary(const std::filesystem::path &file, int boardSize) {
+    FlightPlanTable table;
+
+    table._file = std::make_unique<MappedFile>(file);
+    table.attach(table._file->data(), table._file->size(), boardSize);
+
+    return table;
+}
+
+FlightPlanTable FlightPlanTable::loadText(const std::filesystem::path &file, int boardSize) {
+    int cellCount = boardSize * boardSize;
+
+    std::vector<std::string> plans;
+    std::unordered_map<std::string, std::uint32_t> planIds;
+
+    std::vector<std::vector<std::uint32_t>> uniquePlansByIndex(cellCount);
+    std::vector<std::map<int, std::vector<std::uint32_t>>> plansByIndexBySteps(cellCount);
+
+    int stepsCount = 0;
+
+    std::ifstream stream(file);
+
+    int chunkCount = 0;
+    stream >> chunkCount;
+
+    for (int i = 0; i < chunkCount; i++) {
+        int dx, dy, stepsOptions, uniquePlanCount;
+        stream >> dx >> dy >> stepsOptions >> uniquePlanCount;
+
+        int index = dy * boardSize + dx;
+        auto &uniquePlans = uniquePlansByIndex[index];
+        uniquePlans.reserve(uniquePlanCount);
+
+        for (int j = 0; j < stepsOptions; j++) {
+            int steps, planCount;
+            stream >> steps >> planCount;
+
+            stepsCount = std::max(stepsCount, steps + 1);
+
+            auto &plansBySteps = plansByIndexBySteps[index][steps];
+            plansBySteps.reserve(planCount);
+
+            for (int k = 0; k < planCount; k++) {
+                bool isFirst;
+                std::string plan;
+                stream >> isFirst >> plan;
+
+                auto [planId, inserted] = planIds.try_emplace(plan, plans.size());
+                if (inserted) {
+                    plans.push_back(std::move(plan));
+                }
+
+                if (isFirst) {
+                    uniquePlans.push_back(planId->second);
+                }
+
+                plansBySteps.push_back(planId->second);
+            }
+        }
+    }
+
+    for (auto &uniquePlans : uniquePlansByIndex) {
+        std::stable_sort(uniquePlans.begin(), uniquePlans.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return plans[a].size() < plans[b].size();
+        });
+    }
+
+    std::vector<std::uint32_t> uniqueOffsets{0};
+    std::vector<std::uint32_t> stepsOffsets{0};
+    std::vector<std::uint32_t> references;
+
+    for (const auto &uniquePlans : uniquePlansByIndex) {
+        references.insert(references.end(), uniquePlans.begin(), uniquePlans.end());
+        uniqueOffsets.push_back(references.size());
+    }
+
+    for (const auto &plansBySteps : plansByIndexBySteps) {
+        for (int steps = 0; steps < stepsCount; steps++) {
+            auto stepsPlans = plansBySteps.find(steps);
+            if (stepsPlans != plansBySteps.end()) {
+                references.insert(references.end(), stepsPlans->second.begin(), stepsPlans->second.end());
+            }
+
+            stepsOffsets.push_back(references.size());
+        }
+    }
+
+    std::vector<std::uint32_t> partOffsets{0};
+    std::vector<std::uint8_t> lengthsAndParts;
+
+    for (const auto &plan : plans) {
+        lengthsAndParts.push_back(plan.size());
+    }
+
+    for (const auto &plan : plans) {
+        for (const auto &part : FlightPlan::parse(plan)) {
+            lengthsAndParts.push_back(part.encode());
+        }
+
+        partOffsets.push_back(lengthsAndParts.size() - plans.size());
+    }
+
+    FlightPlanTable table;
+
+    auto &buffer = table._buffer;
+    buffer = {MAGIC,
+              VERSION,
+              static_cast<std::uint32_t>(boardSize),
+              static_cast<std::uint32_t>(stepsCount),
+              static_cast<std::uint32_t>(plans.size()),
+              static_cast<std::uint32_t>(references.size()),
+              partOffsets.back()};
+
+    buffer.insert(buffer.end(), uniqueOffsets.begin(), uniqueOffsets.end());
+    buffer.insert(buffer.end(), stepsOffsets.begin(), stepsOffsets.end());
+    buffer.insert(buffer.end(), references.begin(), references.end());
+    buffer.insert(buffer.end(), partOffsets.begin(), partOffsets.end());
+
+    std::size_t bytesStart = buffer.size();
+    buffer.resize(bytesStart + (lengthsAndParts.size() + 3) / 4);
+    std::memcpy(buffer.data() + bytesStart, lengthsAndParts.data(), lengthsAndParts.size());
+
+    table.attach(reinterpret_cast<const char *>(buffer.data()), buffer.size() * 4, boardSize);
+
+    return table;
+}
+
+FlightPlanTable::PlanList FlightPlanTable::getPlans(int index) const {
+    return {this, _references + _uniqueOffsets[index], _references + _uniqueOffsets[index + 1]};
+}
+
+FlightPlanTable::PlanList FlightPlanTable::getPlans(int index, int steps) const {
+    if (steps < 0 || steps >= _stepsCount) {
+        return {this, _references, _references};
+    }
+
+    int offset = index * _stepsCount + steps;
+    return {this, _references + _stepsOffsets[offset], _references + _stepsOffsets[offset + 1]};
+}
+
+void FlightPlanTable::attach(const char *data, std::size_t size, int boardSize) {
+    const auto *values = reinterpret_cast<const std::uint32_t *>(data);
+    std::size_t valueCount = size / 4;
+
+    if (valueCount < 7 || values[0] != MAGIC || values[1] != VERSION) {
+        throw std::runtime_error("Invalid flight plan table");
+    }
+
+    if (values[2] != static_cast<std::uint32_t>(boardSize)) {
+        throw std::runtime_error("Flight plan table has board size " + std::to_string(values[2])
+                                 + " instead of " + std::to_string(boardSize));
+    }
+
+    std::size_t cellCount = boardSize * boardSize;
+
+    _boardSize = boardSize;
+    _stepsCount = values[3];
+
+    std::uint32_t planCount = values[4];
+    std::uint32_t referenceCount = values[5];
+    std::uint32_t partCount = values[6];
+
+    std::size_t uniqueOffsetsStart = 7;
+    std::size_t stepsOffsetsStart = uniqueOffsetsStart + cellCount + 1;
+    std::size_t referencesStart = stepsOffsetsStart + cellCount * _stepsCount + 1;
+    std::size_t partOffsetsStart = referencesStart + referenceCount;
+    std::size_t bytesStart = (partOffsetsStart + planCount + 1) * 4;
+
+    if (bytesStart + planCount + partCount > size) {
+        throw std::runtime_error("Truncated flight plan table");
+    }
+
+    _uniqueOffsets = values + uniqueOffsetsStart;
+    _stepsOffsets = values + stepsOffsetsStart;
+    _references = values + referencesStart;
+    _partOffsets = values + partOffsetsStart;
+    _lengths = reinterpret_cast<const std::uint8_t *>(data + bytesStart);
+    _parts = _lengths + planCount;
+}
+
+EncodedFlightPlan FlightPlanTable::getPlan(std::uint32_t plan) const {
+    return {_parts + _partOffsets[plan],
+            static_cast<int>(_partOffsets[plan + 1] - _partOffsets[plan]),
+            static_cast<int>(getPlanLength(plan))};
+}
+
+std::size_t FlightPlanTable::getPlanLength(std::uint32_t plan) const {
+    return _lengths[plan];
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <core/FlightPlan.h>
+#include <strategy/MappedFile.h>
+
+/**
+ * Flight plans indexed by target offset and by target offset and step count, stored in a single flat buffer. Every
+ * list of plans is ordered by plan length, so the plans up to a given length form a prefix of the list.
+ *
+ * The buffer has the same layout as the binary plan files written by scripts/generate_flight_plans.py, so binary
+ * files are memory-mapped as-is while text files are converted into an owned buffer. All values are little-endian
+ * uint32s, in this order:
+ * - header: magic, version, board size, steps count, plan count, reference count, part count
+ * - offset of the unique plans per target index in the references (board size^2 + 1)
+ * - offset of the plans per target index and step count in the references (board size^2 * steps count + 1)
+ * - plan references (reference count)
+ * - offset of every plan in the parts (plan count + 1)
+ * - string length of every plan (plan count, one uint8 each)
+ * - parts encoded by FlightPlanPart::encode() (part count, one uint8 each)
+ */
+class FlightPlanTable {
+public:
+    static constexpr std::uint32_t MAGIC = 0x4250464b;
+    static constexpr std::uint32_t VERSION = 3;
+
+    class PlanList {
+        const FlightPlanTable *_table;
+        const std::uint32_t *_begin;
+        const std::uint32_t *_end;
+
+    public:
+        class Iterator {
+            const FlightPlanTable *_table;
+            const std::uint32_t *_reference;
+
+        public:
+            Iterator(const FlightPlanTable *table, const std::uint32_t *reference);
+
+            [[nodiscard]] EncodedFlightPlan operator*() const;
+
+            Iterator &operator++();
+
+            [[nodiscard]] bool operator==(const Iterator &other) const;
+            [[nodiscard]] bool operator!=(const Iterator &other) const;
+        };
+
+        PlanList();
+        PlanList(const FlightPlanTable *table, const std::uint32_t *begin, const std::uint32_t *end);
+
+        [[nodiscard]] Iterator begin() const;
+        [[nodiscard]] Iterator end() const;
+
+        [[nodiscard]] std::size_t size() const;
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] EncodedFlightPlan operator[](std::size_t index) const;
+
+        /**
+         * Returns the prefix of this list containing the plans that are at most maxLength characters long.
+         */
+        [[nodiscard]] PlanList withMaxLength(std::size_t maxLength) const;
+    };
+
+private:
+    std::unique_ptr<MappedFile> _file;
+    std::vector<std::uint32_t> _buffer;
+
+    int _boardSize;
+    int _stepsCount;
+
+    const std::uint32_t *_uniqueOffsets;
+    const std::uint32_t *_stepsOffsets;
+    const std::uint32_t *_references;
+    const std::uint32_t *_partOffsets;
+    const std::uint8_t *_lengths;
+    const std::uint8_t *_parts;
+
+public:
+    FlightPlanTable(FlightPlanTable &&other) = default;
+    FlightPlanTable &operator=(FlightPlanTable &&other) = default;
+
+    /**
+     * Loads the binary file next to the given text file if it exists and is valid, otherwise the text file.
+     */
+    [[nodiscard]] static FlightPlanTable load(const std::filesystem::path &textFile, int boardSize);
+
+    [[nodiscard]] static FlightPlanTable loadBinary(const std::filesystem::path &file, int boardSize);
+    [[nodiscard]] static FlightPlanTable loadText(const std::filesystem::path &file, int boardSize);
+
+    [[nodiscard]] PlanList getPlans(int index) const;
+    [[nodiscard]] PlanList getPlans(int index, int steps) const;
+
+private:
+    FlightPlanTable();
+
+    void attach(const char *data, std::size_t size, int boardSize);
+
+    [[nodiscard]] EncodedFlightPlan getPlan(std::uint32_t plan) const;
+    [[nodiscard]] std::size_t getPlanLength(std::uint32_t plan) const;
+};
@@ -0,0 +1,49 @@
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <strategy/MappedFile.h>
+
+MappedFile::MappedFile(const std::filesystem::path &file) : _data(nullptr), _size(0) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Cannot open " + file.string());
+    }
+
+    struct stat status{};
+    if (fstat(fd, &status) == -1) {
+        close(fd);
+        throw std::runtime_error("Cannot stat " + file.string());
+    }
+
+    _size = status.st_size;
+
+    if (_size > 0) {
+        void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map " + file.string());
+        }
+
+        _data = static_cast<const char *>(data);
+    }
+
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (_data != nullptr) {
+        munmap(const_cast<char *>(_data), _size);
+    }
+}
+
+const char *MappedFile::data() const {
+    return _data;
+}
+
+std::size_t MappedFile::size() const {
+    return _size;
+}
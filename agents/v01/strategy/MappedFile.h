@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+/**
+ * A read-only memory mapping of a whole file, unmapped when the object is destroyed.
+ */
+class MappedFile {
+    const char *_data;
+    std::size_t _size;
+
+public:
+    explicit MappedFile(const std::filesystem::path &file);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    [[nodiscard]] const char *data() const;
+    [[nodiscard]] std::size_t size() const;
+};
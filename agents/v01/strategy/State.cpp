@@ -1,13 +1,150 @@
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
 #include <strategy/State.h>
 
+namespace {
+    // Observations round kore to three decimals
+    const double KORE_TOLERANCE = 1e-3;
+
+    bool isNear(double a, double b) {
+        return std::abs(a - b) <= KORE_TOLERANCE;
+    }
+
+    bool predicts(const Board &predicted, const Board &observed) {
+        if (predicted.step != observed.step
+            || predicted.players.size() != observed.players.size()
+            || predicted.shipyards.size() != observed.shipyards.size()
+            || predicted.fleets.size() != observed.fleets.size()
+            || predicted.cells.count() != observed.cells.count()) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < predicted.players.size(); i++) {
+            if (!isNear(predicted.players[i].kore, observed.players[i].kore)) {
+                return false;
+            }
+        }
+
+        // Entities are matched by id, as the observation may list them in another order than the simulation
+        for (const auto &a : predicted.shipyards) {
+            const auto *b = observed.findShipyard(a.id);
+
+            if (b == nullptr || a.cell != b->cell || a.player != b->player || a.ships != b->ships
+                || a.turnsControlled != b->turnsControlled) {
+                return false;
+            }
+        }
+
+        for (const auto &a : predicted.fleets) {
+            const auto *b = observed.findFleet(a.id);
+
+            if (b == nullptr || a.cell != b->cell || a.player != b->player || a.ships != b->ships
+                || a.direction != b->direction || a.getRemainingFlightPlan() != b->getRemainingFlightPlan()
+                || !isNear(a.kore, b->kore)) {
+                return false;
+            }
+        }
+
+        for (int i = 0, iMax = predicted.cells.count(); i < iMax; i++) {
+            if (!isNear(predicted.cells.kore(i), observed.cells.kore(i))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
 State::State(Board &board)
         : board(board),
           koreLeft(board.me().kore),
           availableShips(),
-          savingForEnd(board.step >= board.config.episodeSteps - 50
-                       && board.me().shipyards.size() >= board.opponent().shipyards.size()),
-          timer() {
-    for (const auto &shipyard : board.me().shipyards) {
-        availableShips[shipyard->id] = shipyard->ships;
+          savingForEnd(board.step >= board.config().episodeSteps - 50
+                       && board.shipyardsOf(board.me().id).size() >= board.shipyardsOf(board.opponent().id).size()),
+          timer(),
+          _reusedFutureSteps(0),
+          _simulatedFutureSteps(0) {
+    for (const auto &shipyard : board.shipyardsOf(board.me().id)) {
+        availableShips[shipyard.id] = shipyard.ships;
     }
 }
+
+const std::deque<Board> &State::getFuture(int steps, FutureScenario scenario) {
+    auto &trajectory = scenario == FutureScenario::PASSIVE ? _passiveFuture : _opponentMaxSpawnFuture;
+
+    if (trajectory.boards.empty() || !hasSameActions(trajectory)) {
+        recordActions(trajectory);
+
+        trajectory.boards.clear();
+        trajectory.boards.push_back(board.copy());
+
+        if (scenario == FutureScenario::OPPONENT_MAX_SPAWN) {
+            trajectory.boards.back().opponent().kore = 1e9;
+        }
+    }
+
+    while ((int) trajectory.boards.size() <= steps) {
+        Board nextBoard = trajectory.boards.back().copy();
+
+        if (scenario == FutureScenario::OPPONENT_MAX_SPAWN) {
+            for (auto &shipyard : nextBoard.shipyardsOf(nextBoard.opponent().id)) {
+                shipyard.action = Action::spawn(shipyard.getSpawnMaximum());
+            }
+        }
+
+        nextBoard.next();
+        trajectory.boards.push_back(std::move(nextBoard));
+
+        _simulatedFutureSteps++;
+    }
+
+    return trajectory.boards;
+}
+
+void State::continueFuture(std::deque<Board> previousFuture) {
+    if (previousFuture.size() < 2 || !predicts(previousFuture[1], board)) {
+        return;
+    }
+
+    previousFuture.pop_front();
+    previousFuture.front() = board.copy();
+
+    recordActions(_passiveFuture);
+    _passiveFuture.boards = std::move(previousFuture);
+
+    _reusedFutureSteps += (int) _passiveFuture.boards.size() - 1;
+}
+
+std::deque<Board> State::releaseFuture() {
+    _passiveFuture.actions.clear();
+    return std::move(_passiveFuture.boards);
+}
+
+double State::getFutureReuseRatio() const {
+    int totalSteps = _reusedFutureSteps + _simulatedFutureSteps;
+    return totalSteps == 0 ? 0.0 : (double) _reusedFutureSteps / (double) totalSteps;
+}
+
+void State::recordActions(Trajectory &trajectory) const {
+    trajectory.actions.clear();
+    for (const auto &shipyard : board.shipyards) {
+        trajectory.actions.emplace_back(shipyard.id, shipyard.action);
+    }
+}
+
+bool State::hasSameActions(const Trajectory &trajectory) const {
+    if (trajectory.actions.size() != board.shipyards.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < board.shipyards.size(); i++) {
+        const auto &[id, action] = trajectory.actions[i];
+        if (id != board.shipyards[i].id || action != board.shipyards[i].action) {
+            return false;
+        }
+    }
+
+    return true;
+}
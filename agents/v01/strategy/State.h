@@ -1,19 +1,76 @@
 #pragma once
 
-#include <string>
+#include <deque>
+#include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <core/Action.h>
 #include <core/Board.h>
+#include <core/EntityId.h>
 #include <strategy/Timer.h>
 
+enum class FutureScenario {
+    /**
+     * Nobody sets any further actions.
+     */
+    PASSIVE,
+
+    /**
+     * The opponent has unlimited kore and spawns the maximum at each of its shipyards every turn.
+     */
+    OPPONENT_MAX_SPAWN
+};
+
 struct State {
     Board &board;
 
     double koreLeft;
-    std::unordered_map<std::string, int> availableShips;
+    std::unordered_map<EntityId, int> availableShips;
     bool savingForEnd;
 
     Timer timer;
 
     explicit State(Board &board);
+
+    /**
+     * Returns the boards following the current board in the given scenario, indexed by the number of turns ahead and
+     * starting with a copy of the current board, with at least steps + 1 entries. The actions currently set on the
+     * board are part of the first turn.
+     * The trajectory is computed once per turn and only recomputed after the actions on the board change, which also
+     * invalidates references to the previous one.
+     */
+    [[nodiscard]] const std::deque<Board> &getFuture(int steps, FutureScenario scenario = FutureScenario::PASSIVE);
+
+    /**
+     * Continues the passive future of the previous turn if its second board predicted the current board, so only
+     * steps beyond its end need to be simulated. Must be called before any actions are set.
+     */
+    void continueFuture(std::deque<Board> previousFuture);
+
+    /**
+     * Moves the passive future out of this state so the next turn can continue it.
+     */
+    [[nodiscard]] std::deque<Board> releaseFuture();
+
+    /**
+     * Returns the fraction of the future boards produced this turn that were taken from the previous turn.
+     */
+    [[nodiscard]] double getFutureReuseRatio() const;
+
+private:
+    struct Trajectory {
+        std::vector<std::pair<EntityId, std::optional<Action>>> actions;
+        std::deque<Board> boards;
+    };
+
+    Trajectory _passiveFuture;
+    Trajectory _opponentMaxSpawnFuture;
+
+    int _reusedFutureSteps;
+    int _simulatedFutureSteps;
+
+    void recordActions(Trajectory &trajectory) const;
+    [[nodiscard]] bool hasSameActions(const Trajectory &trajectory) const;
 };
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <utility>
 
 #include <core/Shipyard.h>
 #include <strategy/State.h>
@@ -11,7 +12,10 @@
 #include <strategy/components/SpawnGreedyComponent.h>
 #include <strategy/components/SpawnNormalComponent.h>
 
-Strategy::Strategy(const Configuration &config) : _flightPlanDatabase(std::make_unique<FlightPlanDatabase>(config)) {
+Strategy::Strategy(const Configuration &config)
+        : _flightPlanDatabase(std::make_unique<FlightPlanDatabase>(config)),
+          _executor(std::make_unique<Executor>()),
+          _futureReuseRatio(0.0) {
     registerComponent<DefendComponent>();
     registerComponent<AttackShipyardComponent>();
     registerComponent<AttackFleetComponent>();
@@ -23,24 +27,29 @@ Strategy::Strategy(const Configuration &config) : _flightPlanDatabase(std::make_
 
 void Strategy::run(Board &board) {
     Board::COPY_CALLS = 0;
+    Board::FORK_CALLS = 0;
     Board::NEXT_CALLS = 0;
 
-    std::sort(board.me().shipyards.begin(),
-              board.me().shipyards.end(),
-              [](const std::unique_ptr<Shipyard> &a, const std::unique_ptr<Shipyard> &b) {
-                  return a->turnsControlled < b->turnsControlled;
-              });
+    board.sortShipyards(board.me().id, [](const Shipyard &a, const Shipyard &b) {
+        return a.turnsControlled < b.turnsControlled;
+    });
 
     State state(board);
+    state.continueFuture(std::move(_previousFuture));
 
     for (const auto &component : _components) {
         component->run(state);
     }
+
+    _previousFuture = state.releaseFuture();
+    _futureReuseRatio = state.getFutureReuseRatio();
 }
 
 std::unordered_map<std::string, double> Strategy::getMetrics() const {
     return {
-            {"boardCopyCalls", Board::COPY_CALLS},
-            {"boardNextCalls", Board::NEXT_CALLS}
+            {"boardCopyCalls", Board::COPY_CALLS.load()},
+            {"boardForkCalls", Board::FORK_CALLS.load()},
+            {"boardNextCalls", Board::NEXT_CALLS.load()},
+            {"futureReuseRatio", _futureReuseRatio}
     };
 }
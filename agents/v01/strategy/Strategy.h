@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -8,13 +9,19 @@
 #include <core/Action.h>
 #include <core/Board.h>
 #include <core/Configuration.h>
+#include <strategy/Executor.h>
+#include <strategy/FlightPlanDatabase.h>
 #include <strategy/StrategyComponent.h>
 
 class Strategy {
     std::unique_ptr<FlightPlanDatabase> _flightPlanDatabase;
+    std::unique_ptr<Executor> _executor;
 
     std::vector<std::unique_ptr<StrategyComponent>> _components;
 
+    std::deque<Board> _previousFuture;
+    double _futureReuseRatio;
+
 public:
     explicit Strategy(const Configuration &config);
 
@@ -25,6 +32,6 @@ public:
 private:
     template<typename T>
     void registerComponent() {
-        _components.push_back(std::make_unique<T>(*_flightPlanDatabase));
+        _components.push_back(std::make_unique<T>(*_flightPlanDatabase, *_executor));
     }
 };
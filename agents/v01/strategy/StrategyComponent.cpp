@@ -4,11 +4,12 @@
 #include <core/Action.h>
 #include <strategy/StrategyComponent.h>
 
-StrategyComponent::StrategyComponent(FlightPlanDatabase &flightPlanDatabase)
-        : _flightPlanDatabase(flightPlanDatabase) {}
+StrategyComponent::StrategyComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : _flightPlanDatabase(flightPlanDatabase),
+          _executor(executor) {}
 
 void StrategyComponent::spawnMax(State &state, Shipyard &shipyard, bool allowZero) const {
-    double spawnCost = state.board.config.spawnCost;
+    double spawnCost = state.board.config().spawnCost;
 
     int maxSpawn = std::min((int) std::floor(state.koreLeft / spawnCost), shipyard.getSpawnMaximum());
     if (!allowZero && maxSpawn == 0) {
@@ -1,15 +1,17 @@
 #pragma once
 
 #include <core/Shipyard.h>
+#include <strategy/Executor.h>
 #include <strategy/FlightPlanDatabase.h>
 #include <strategy/State.h>
 
 class StrategyComponent {
 protected:
     FlightPlanDatabase &_flightPlanDatabase;
+    Executor &_executor;
 
 public:
-    explicit StrategyComponent(FlightPlanDatabase &flightPlanDatabase);
+    StrategyComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor);
 
     virtual ~StrategyComponent() = default;
 
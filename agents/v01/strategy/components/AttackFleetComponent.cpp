@@ -1,19 +1,24 @@
 #include <algorithm>
+#include <cstddef>
+#include <deque>
 #include <limits>
-#include <string>
+#include <optional>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <core/Action.h>
 #include <core/Board.h>
+#include <core/BoardArena.h>
+#include <core/EntityId.h>
+#include <core/OccupancyTable.h>
 #include <strategy/components/AttackFleetComponent.h>
 
-AttackFleetComponent::AttackFleetComponent(FlightPlanDatabase &flightPlanDatabase)
-        : StrategyComponent(flightPlanDatabase) {}
+AttackFleetComponent::AttackFleetComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : StrategyComponent(flightPlanDatabase, executor) {}
 
 void AttackFleetComponent::run(State &state) {
-    std::unordered_set<std::string> attackedFleets;
+    std::unordered_set<EntityId> attackedFleets;
 
     std::vector<std::pair<int, int>> offsets{
             {1,  0},
@@ -22,30 +27,102 @@ void AttackFleetComponent::run(State &state) {
             {0,  -1}
     };
 
-    Board futureBoard = state.board.copy();
+    // The table finds the cells next to opponent fleets without scanning the whole board and answers for the cells
+    // around which no fleet may have interacted yet, only the other ones are read from the simulated future
+    OccupancyTable occupancy(state.board, 30);
+
+    const std::deque<Board> *future = nullptr;
+    if (occupancy.getExactSteps() < 30) {
+        future = &state.getFuture(30);
+    }
+
+    int opponent = state.board.opponent().id;
+
+    struct Target {
+        EntityId id;
+        int player;
+        int ships;
+    };
+
+    auto isFree = [&](int step, int cellIndex, bool certain) {
+        if (certain) {
+            return !occupancy.hasShipyard(step, cellIndex) && occupancy.at(step, cellIndex).empty();
+        }
+
+        const auto &futureCell = (*future)[step].cells.at(cellIndex);
+        return futureCell.shipyard == -1 && !futureCell.hasFleets();
+    };
+
+    auto firstFleetAt = [&](int step, int cellIndex, bool certain) -> std::optional<Target> {
+        if (certain) {
+            auto occupants = occupancy.at(step, cellIndex);
+            if (occupants.empty()) {
+                return std::nullopt;
+            }
+
+            const auto &fleet = occupancy.getFleet(occupants.begin()->fleet);
+            return Target{fleet.id, fleet.player, fleet.ships};
+        }
+
+        const auto &futureBoard = (*future)[step];
+        const auto &futureCell = futureBoard.cells.at(cellIndex);
+        if (!futureCell.hasFleets()) {
+            return std::nullopt;
+        }
+
+        const auto &fleet = futureBoard.fleets[futureCell.firstFleet];
+        return Target{fleet.id, fleet.player, fleet.ships};
+    };
+
     for (int i = 0; i < 30; i++) {
-        futureBoard.next();
+        int step = i + 1;
+
+        // Every fleet that may exist at that step is in the table, so only the cells next to one can be targets
+        std::vector<int> candidateCells;
+        for (const auto &occupant : occupancy.at(step)) {
+            if (occupancy.getFleet(occupant.fleet).player != opponent) {
+                continue;
+            }
+
+            const auto &occupantCell = state.board.cells.at(occupant.cell);
+            for (const auto &[dx, dy] : offsets) {
+                candidateCells.push_back(state.board.cells.at(occupantCell.x + dx, occupantCell.y + dy).index);
+            }
+        }
+
+        std::sort(candidateCells.begin(), candidateCells.end());
+        candidateCells.erase(std::unique(candidateCells.begin(), candidateCells.end()), candidateCells.end());
+
+        for (int cellIndex : candidateCells) {
+            const auto &cell = state.board.cells.at(cellIndex);
+
+            int neighbors[4];
+            bool certain = occupancy.isCertain(step, cellIndex);
+
+            for (std::size_t k = 0; k < offsets.size(); k++) {
+                const auto &[dx, dy] = offsets[k];
+                neighbors[k] = state.board.cells.at(cell.x + dx, cell.y + dy).index;
+                certain = certain && occupancy.isCertain(step, neighbors[k]);
+            }
 
-        for (const auto &cell : futureBoard.cells) {
-            if (cell.shipyard != nullptr || !cell.fleets.empty()) {
+            if (!isFree(step, cellIndex, certain)) {
                 continue;
             }
 
-            std::vector<std::string> fleets;
+            std::vector<EntityId> fleets;
+            std::vector<int> futureShips;
             int maxAttackSize = std::numeric_limits<int>::max();
 
-            for (const auto &[dx, dy] : offsets) {
-                const auto &neighborCell = futureBoard.cells.at(cell.x + dx, cell.y + dy);
-                if (!neighborCell.fleets.empty()) {
-                    const auto &fleet = neighborCell.fleets[0];
-                    if (fleet->player->id != futureBoard.opponent().id) {
-                        continue;
-                    }
+            for (int neighbor : neighbors) {
+                auto fleet = firstFleetAt(step, neighbor, certain);
+                if (!fleet.has_value() || fleet->player != opponent) {
+                    continue;
+                }
 
-                    if (attackedFleets.find(fleet->id) == attackedFleets.end()) {
-                        fleets.push_back(fleet->id);
-                        maxAttackSize = std::min(maxAttackSize, fleet->ships);
-                    }
+                if (attackedFleets.find(fleet->id) == attackedFleets.end()) {
+                    fleets.push_back(fleet->id);
+                    futureShips.push_back(fleet->ships);
+                    maxAttackSize = std::min(maxAttackSize, fleet->ships);
                 }
             }
 
@@ -53,41 +130,42 @@ void AttackFleetComponent::run(State &state) {
                 continue;
             }
 
-            for (const auto &shipyard : state.board.me().shipyards) {
-                if (shipyard->action.has_value() || state.availableShips[shipyard->id] == 0) {
+            for (auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+                if (shipyard.action.has_value() || state.availableShips[shipyard.id] == 0) {
                     continue;
                 }
 
-                int attackSize = std::min(maxAttackSize, state.availableShips[shipyard->id]);
+                int attackSize = std::min(maxAttackSize, state.availableShips[shipyard.id]);
 
-                auto plans = _flightPlanDatabase.getTargetPlans(*shipyard->cell, cell, attackSize, i + 1);
+                auto plans = _flightPlanDatabase.getTargetPlans(state.board.cells.at(shipyard.cell),
+                                                                cell,
+                                                                attackSize,
+                                                                i + 1);
                 if (plans.empty()) {
                     continue;
                 }
 
-                bool foundPlan = false;
-                for (int j = 0; j < 10 && j < plans.size(); j++) {
-                    Board testBoard = state.board.copy();
-                    testBoard.shipyardsById[shipyard->id]->action = Action::launch(attackSize, plans[j]);
+                int foundPlan = _executor.findFirst(std::min(10, (int) plans.size()), [&](int j) {
+                    BoardArena::Scope arena;
+                    Board testBoard = state.board.fork(arena.resource());
+                    testBoard.findShipyard(shipyard.id)->action = Action::launch(attackSize, plans[j]);
 
                     for (int k = 0; k <= i; k++) {
                         testBoard.next();
                     }
 
-                    foundPlan = true;
-                    for (const auto &fleet : fleets) {
-                        if (testBoard.fleetsById.find(fleet) != testBoard.fleetsById.end()
-                            && testBoard.fleetsById[fleet]->ships >= futureBoard.fleetsById[fleet]->ships) {
-                            foundPlan = false;
-                            break;
+                    for (std::size_t k = 0; k < fleets.size(); k++) {
+                        const auto *testFleet = testBoard.findFleet(fleets[k]);
+                        if (testFleet != nullptr && testFleet->ships >= futureShips[k]) {
+                            return false;
                         }
                     }
 
-                    if (!foundPlan) {
-                        continue;
-                    }
+                    return true;
+                });
 
-                    shipyard->action = Action::launch(attackSize, plans[j]);
+                if (foundPlan != -1) {
+                    shipyard.action = Action::launch(attackSize, plans[foundPlan]);
 
                     for (const auto &fleet : fleets) {
                         attackedFleets.insert(fleet);
@@ -95,10 +173,6 @@ void AttackFleetComponent::run(State &state) {
 
                     break;
                 }
-
-                if (foundPlan) {
-                    break;
-                }
             }
         }
     }
@@ -1,12 +1,13 @@
 #pragma once
 
+#include <strategy/Executor.h>
 #include <strategy/FlightPlanDatabase.h>
 #include <strategy/State.h>
 #include <strategy/StrategyComponent.h>
 
 class AttackFleetComponent : public StrategyComponent {
 public:
-    explicit AttackFleetComponent(FlightPlanDatabase &flightPlanDatabase);
+    AttackFleetComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor);
 
     void run(State &state) override;
 };
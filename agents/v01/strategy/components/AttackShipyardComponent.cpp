@@ -5,64 +5,63 @@
 #include <core/Board.h>
 #include <strategy/components/AttackShipyardComponent.h>
 
-AttackShipyardComponent::AttackShipyardComponent(FlightPlanDatabase &flightPlanDatabase)
-        : StrategyComponent(flightPlanDatabase) {}
+AttackShipyardComponent::AttackShipyardComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : StrategyComponent(flightPlanDatabase, executor) {}
 
 void AttackShipyardComponent::run(State &state) {
-    Board futureBoard = state.board.copy();
-    futureBoard.opponent().kore = 1e9;
+    const auto &future = state.getFuture(50, FutureScenario::OPPONENT_MAX_SPAWN);
+
+    Board testBoard = state.board.fork();
 
     for (int i = 0; i < 50; i++) {
-        for (const auto &shipyard : futureBoard.opponent().shipyards) {
-            shipyard->action = Action::spawn(shipyard->getSpawnMaximum());
-        }
+        const auto &futureBoard = future[i + 1];
 
-        futureBoard.next();
+        for (const auto &opponentShipyard : futureBoard.shipyardsOf(futureBoard.opponent().id)) {
+            int requiredShips = opponentShipyard.ships * 1.2;
 
-        for (const auto &opponentShipyard : futureBoard.opponent().shipyards) {
-            int requiredShips = opponentShipyard->ships * 1.2;
+            const auto &opponentCell = futureBoard.cells.at(opponentShipyard.cell);
 
             int defendingDistance = std::numeric_limits<int>::max();
-            for (const auto &otherOpponentShipyard : futureBoard.opponent().shipyards) {
-                if (opponentShipyard->id != otherOpponentShipyard->id) {
+            for (const auto &otherOpponentShipyard : futureBoard.shipyardsOf(futureBoard.opponent().id)) {
+                if (opponentShipyard.id != otherOpponentShipyard.id) {
                     defendingDistance = std::min(defendingDistance,
-                                                 opponentShipyard->cell->distanceTo(*otherOpponentShipyard->cell));
+                                                 futureBoard.topology().distance(opponentShipyard.cell,
+                                                                                 otherOpponentShipyard.cell));
                 }
             }
 
-            for (const auto &myShipyard : state.board.me().shipyards) {
-                if (myShipyard->action.has_value()
-                    || myShipyard->getSpawnMaximum() < 5
-                    || state.availableShips[myShipyard->id] < requiredShips
-                    || myShipyard->cell->distanceTo(*opponentShipyard->cell) > defendingDistance * 1.5) {
+            for (auto &myShipyard : state.board.shipyardsOf(state.board.me().id)) {
+                const auto &myCell = state.board.cells.at(myShipyard.cell);
+
+                if (myShipyard.action.has_value()
+                    || myShipyard.getSpawnMaximum() < 5
+                    || state.availableShips[myShipyard.id] < requiredShips
+                    || state.board.topology().distance(myCell.index, opponentCell.index) > defendingDistance * 1.5) {
                     continue;
                 }
 
-                const auto &plans = _flightPlanDatabase.getTargetPlans(*myShipyard->cell,
-                                                                       *opponentShipyard->cell,
-                                                                       requiredShips,
-                                                                       i + 1);
+                const auto &plans = _flightPlanDatabase.getTargetPlans(myCell, opponentCell, requiredShips, i + 1);
 
                 if (plans.empty()) {
                     continue;
                 }
 
-                Board testBoard = state.board.copy();
+                testBoard.discard();
                 testBoard.opponent().kore = 1e9;
 
-                testBoard.shipyardsById[myShipyard->id]->action = Action::launch(requiredShips, plans[0]);
+                testBoard.findShipyard(myShipyard.id)->action = Action::launch(requiredShips, plans[0]);
 
                 for (int j = 0; j <= i; j++) {
-                    for (const auto &shipyard : testBoard.opponent().shipyards) {
-                        shipyard->action = Action::spawn(shipyard->getSpawnMaximum());
+                    for (auto &shipyard : testBoard.shipyardsOf(testBoard.opponent().id)) {
+                        shipyard.action = Action::spawn(shipyard.getSpawnMaximum());
                     }
 
                     testBoard.next();
                 }
 
-                const auto &targetCell = testBoard.cells.at(*opponentShipyard->cell);
-                if (targetCell.shipyard != nullptr && targetCell.shipyard->player->id == myShipyard->player->id) {
-                    myShipyard->action = Action::launch(requiredShips, plans[0]);
+                const auto *targetShipyard = testBoard.shipyardAt(testBoard.cells.at(opponentShipyard.cell));
+                if (targetShipyard != nullptr && targetShipyard->player == myShipyard.player) {
+                    myShipyard.action = Action::launch(requiredShips, plans[0]);
                 }
             }
         }
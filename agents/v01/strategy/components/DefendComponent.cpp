@@ -1,70 +1,49 @@
 #include <algorithm>
-#include <string>
+#include <cstddef>
+#include <deque>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <core/Action.h>
 #include <core/Board.h>
+#include <core/BoardArena.h>
+#include <core/EntityId.h>
 #include <strategy/components/DefendComponent.h>
 
-DefendComponent::DefendComponent(FlightPlanDatabase &flightPlanDatabase)
-        : StrategyComponent(flightPlanDatabase) {}
+DefendComponent::DefendComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : StrategyComponent(flightPlanDatabase, executor) {}
 
 void DefendComponent::run(State &state) {
-    std::unordered_map<std::string, std::vector<std::pair<int, int>>> requiredDefenseByShipyards;
+    std::unordered_map<EntityId, std::vector<std::pair<int, int>>> requiredDefenseByShipyards;
 
-    for (const auto &shipyard : state.board.me().shipyards) {
-        std::vector<std::pair<int, int>> requiredDefenseBySteps;
-
-        int currentRequiredDefense = 0;
-        int previousShips = shipyard->ships;
-        bool previousIsMine = true;
+    std::vector<Shipyard *> myShipyards;
+    for (auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        myShipyards.push_back(&shipyard);
+    }
 
-        Board futureBoard = state.board.copy();
-        futureBoard.opponent().kore = 1e9;
+    // Projections start from the actions set so far, so they are computed ahead in batches and recomputed whenever
+    // a shipyard before them gets an action
+    std::vector<std::vector<std::pair<int, int>>> projections(myShipyards.size());
+    std::size_t projected = 0;
 
-        for (int i = 0; i < 30; i++) {
-            futureBoard.next();
+    for (std::size_t k = 0; k < myShipyards.size(); k++) {
+        auto &shipyard = *myShipyards[k];
 
-            const auto &currentShipyard = futureBoard.cells.at(*shipyard->cell).shipyard;
-            if (currentShipyard == nullptr) {
-                continue;
-            }
+        if (k == projected) {
+            const auto &future = state.getFuture(30);
 
-            int currentShips = currentShipyard->ships;
-            bool currentIsMine = currentShipyard->player->id == futureBoard.me().id;
+            int count = std::min(_executor.getThreadCount(), (int) (myShipyards.size() - k));
+            _executor.forEach(count, [&](int i) {
+                projections[k + i] = projectRequiredDefense(future, *myShipyards[k + i]);
+            });
 
-            if (currentIsMine && currentIsMine == previousIsMine) {
-                if (currentShips < previousShips) {
-                    currentRequiredDefense += previousShips - currentShips;
-                } else if (currentShips > previousShips) {
-                    currentRequiredDefense -= currentShips - previousShips;
-                }
-            } else if (!currentIsMine && currentIsMine == previousIsMine) {
-                if (currentShips < previousShips) {
-                    currentRequiredDefense -= previousShips - currentShips;
-                } else if (currentShips > previousShips) {
-                    currentRequiredDefense += currentShips - previousShips;
-                }
-            } else if (currentIsMine && currentIsMine != previousIsMine) {
-                currentRequiredDefense -= previousShips + currentShips;
-            } else if (!currentIsMine && currentIsMine != previousIsMine) {
-                currentRequiredDefense += previousShips + currentShips;
-            }
-
-            if (!currentIsMine) {
-                currentShipyard->action = Action::spawn(currentShipyard->getSpawnMaximum());
-            }
-
-            if (currentRequiredDefense > 0) {
-                requiredDefenseBySteps.emplace_back(i + 1, currentRequiredDefense);
-            }
-
-            previousShips = currentShips;
-            previousIsMine = currentIsMine;
+            projected = k + count;
         }
 
+        auto requiredDefenseBySteps = std::move(projections[k]);
+
         if (requiredDefenseBySteps.empty()) {
             continue;
         }
@@ -73,7 +52,7 @@ void DefendComponent::run(State &state) {
         for (auto it = requiredDefenseBySteps.begin(); it != requiredDefenseBySteps.end();) {
             maxRequiredDefense = std::max(maxRequiredDefense, it->second);
 
-            it->second -= shipyard->ships;
+            it->second -= shipyard.ships;
             if (it->second <= 0) {
                 it = requiredDefenseBySteps.erase(it);
             } else {
@@ -81,14 +60,16 @@ void DefendComponent::run(State &state) {
             }
         }
 
-        state.availableShips[shipyard->id] = shipyard->ships - std::min(shipyard->ships, maxRequiredDefense);
+        state.availableShips[shipyard.id] = shipyard.ships - std::min(shipyard.ships, maxRequiredDefense);
 
         if (requiredDefenseBySteps.empty()) {
             continue;
         }
 
-        spawnMax(state, *shipyard, false);
-        int spawning = shipyard->action.has_value() ? shipyard->action->ships : 0;
+        spawnMax(state, shipyard, false);
+        projected = k + 1;
+
+        int spawning = shipyard.action.has_value() ? shipyard.action->ships : 0;
 
         for (auto it = requiredDefenseBySteps.begin(); it != requiredDefenseBySteps.end();) {
             it->second -= spawning;
@@ -103,21 +84,23 @@ void DefendComponent::run(State &state) {
             continue;
         }
 
-        requiredDefenseByShipyards[shipyard->id] = std::move(requiredDefenseBySteps);
+        requiredDefenseByShipyards[shipyard.id] = std::move(requiredDefenseBySteps);
     }
 
     int minFleetSize = 5;
 
-    for (const auto &shipyard : state.board.me().shipyards) {
-        if (shipyard->action.has_value() || state.availableShips[shipyard->id] < minFleetSize) {
+    for (auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        if (shipyard.action.has_value() || state.availableShips[shipyard.id] < minFleetSize) {
             continue;
         }
 
-        std::vector<Shipyard *> nearbyShipyards;
-        for (const auto &otherShipyard : state.board.me().shipyards) {
-            if (shipyard->id != otherShipyard->id
-                && requiredDefenseByShipyards.find(otherShipyard->id) != requiredDefenseByShipyards.end()) {
-                nearbyShipyards.push_back(otherShipyard.get());
+        const auto &shipyardCell = state.board.cells.at(shipyard.cell);
+
+        std::vector<const Shipyard *> nearbyShipyards;
+        for (const auto &otherShipyard : state.board.shipyardsOf(state.board.me().id)) {
+            if (shipyard.id != otherShipyard.id
+                && requiredDefenseByShipyards.find(otherShipyard.id) != requiredDefenseByShipyards.end()) {
+                nearbyShipyards.push_back(&otherShipyard);
             }
         }
 
@@ -125,8 +108,10 @@ void DefendComponent::run(State &state) {
             continue;
         }
 
+        const auto &topology = state.board.topology();
+
         std::sort(nearbyShipyards.begin(), nearbyShipyards.end(), [&](const Shipyard *a, const Shipyard *b) {
-            return shipyard->cell->distanceTo(*a->cell) < shipyard->cell->distanceTo(*b->cell);
+            return topology.distance(shipyard.cell, a->cell) < topology.distance(shipyard.cell, b->cell);
         });
 
         for (const auto &otherShipyard : nearbyShipyards) {
@@ -144,15 +129,15 @@ void DefendComponent::run(State &state) {
                 }
 
                 int fleetSize = std::max(minFleetSize,
-                                         std::min(state.availableShips[shipyard->id], maxRequiredDefense));
+                                         std::min(state.availableShips[shipyard.id], maxRequiredDefense));
 
                 for (int j = 1; j <= steps; j++) {
-                    const auto &plans = _flightPlanDatabase.getTargetPlans(*shipyard->cell,
-                                                                           *otherShipyard->cell,
+                    const auto &plans = _flightPlanDatabase.getTargetPlans(shipyardCell,
+                                                                           state.board.cells.at(otherShipyard->cell),
                                                                            fleetSize,
                                                                            j);
                     if (!plans.empty()) {
-                        shipyard->action = Action::launch(fleetSize, plans[0]);
+                        shipyard.action = Action::launch(fleetSize, plans[0]);
                         defendingSteps = j;
                         defendingSize = fleetSize;
                         break;
@@ -190,3 +175,70 @@ void DefendComponent::run(State &state) {
         }
     }
 }
+
+std::vector<std::pair<int, int>> DefendComponent::projectRequiredDefense(const std::deque<Board> &future,
+                                                                       const Shipyard &shipyard) const {
+    std::vector<std::pair<int, int>> requiredDefenseBySteps;
+
+    int currentRequiredDefense = 0;
+    int previousShips = shipyard.ships;
+    bool previousIsMine = true;
+
+    // Follows the shared future until the shipyard is captured, from then on the opponent spawns there every turn
+    BoardArena::Scope arena;
+    std::optional<Board> capturedBoard;
+
+    for (int i = 0; i < 30; i++) {
+        if (capturedBoard.has_value()) {
+            capturedBoard->next();
+        }
+
+        const auto &futureBoard = capturedBoard.has_value() ? *capturedBoard : future[i + 1];
+
+        const auto *currentShipyard = futureBoard.shipyardAt(futureBoard.cells.at(shipyard.cell));
+        if (currentShipyard == nullptr) {
+            continue;
+        }
+
+        int currentShips = currentShipyard->ships;
+        bool currentIsMine = currentShipyard->player == futureBoard.me().id;
+
+        if (currentIsMine && currentIsMine == previousIsMine) {
+            if (currentShips < previousShips) {
+                currentRequiredDefense += previousShips - currentShips;
+            } else if (currentShips > previousShips) {
+                currentRequiredDefense -= currentShips - previousShips;
+            }
+        } else if (!currentIsMine && currentIsMine == previousIsMine) {
+            if (currentShips < previousShips) {
+                currentRequiredDefense -= previousShips - currentShips;
+            } else if (currentShips > previousShips) {
+                currentRequiredDefense += currentShips - previousShips;
+            }
+        } else if (currentIsMine && currentIsMine != previousIsMine) {
+            currentRequiredDefense -= previousShips + currentShips;
+        } else if (!currentIsMine && currentIsMine != previousIsMine) {
+            currentRequiredDefense += previousShips + currentShips;
+        }
+
+        if (!currentIsMine) {
+            int spawnMaximum = currentShipyard->getSpawnMaximum();
+
+            if (!capturedBoard.has_value()) {
+                capturedBoard = future[i + 1].copy(arena.resource());
+                capturedBoard->opponent().kore = 1e9;
+            }
+
+            capturedBoard->shipyardAt(capturedBoard->cells.at(shipyard.cell))->action = Action::spawn(spawnMaximum);
+        }
+
+        if (currentRequiredDefense > 0) {
+            requiredDefenseBySteps.emplace_back(i + 1, currentRequiredDefense);
+        }
+
+        previousShips = currentShips;
+        previousIsMine = currentIsMine;
+    }
+
+    return requiredDefenseBySteps;
+}
@@ -1,12 +1,28 @@
 #pragma once
 
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <core/Board.h>
+#include <core/Shipyard.h>
+#include <strategy/Executor.h>
 #include <strategy/FlightPlanDatabase.h>
 #include <strategy/State.h>
 #include <strategy/StrategyComponent.h>
 
 class DefendComponent : public StrategyComponent {
 public:
-    explicit DefendComponent(FlightPlanDatabase &flightPlanDatabase);
+    DefendComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor);
 
     void run(State &state) override;
+
+private:
+    /**
+     * Follows the future of the board with the opponent spawning as much as possible at the shipyard once captured
+     * and returns the steps at which the shipyard has lost ships, together with the number of ships lost up to that
+     * step.
+     */
+    [[nodiscard]] std::vector<std::pair<int, int>> projectRequiredDefense(const std::deque<Board> &future,
+                                                                        const Shipyard &shipyard) const;
 };
@@ -3,10 +3,12 @@
 #include <unordered_set>
 
 #include <core/Board.h>
+#include <core/BoardArena.h>
 #include <core/FlightPlan.h>
 #include <strategy/components/ExpandComponent.h>
 
-ExpandComponent::ExpandComponent(FlightPlanDatabase &flightPlanDatabase) : StrategyComponent(flightPlanDatabase) {}
+ExpandComponent::ExpandComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : StrategyComponent(flightPlanDatabase, executor) {}
 
 void ExpandComponent::run(State &state) {
     int requiredShipyards = getRequiredShipyards(state);
@@ -16,66 +18,65 @@ void ExpandComponent::run(State &state) {
 
     int minDistance = 3;
     int maxDistance = 5;
-    int requiredShips = state.board.config.convertCost;
+    int requiredShips = state.board.config().convertCost;
 
-    Board futureBoard = state.board.copy();
-    for (int i = 0; i < maxDistance * 2; i++) {
-        futureBoard.next();
-    }
+    const auto &futureBoard = state.getFuture(maxDistance * 2)[maxDistance * 2];
 
-    std::unordered_set<Cell *> usedCells;
+    std::unordered_set<int> usedCells;
 
-    for (const auto &shipyard : state.board.me().shipyards) {
-        if (shipyard->action.has_value() || shipyard->getSpawnMaximum() < 5) {
+    for (auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        if (shipyard.action.has_value() || shipyard.getSpawnMaximum() < 5) {
             continue;
         }
 
-        int fleetSize = state.availableShips[shipyard->id];
+        const auto &shipyardCell = state.board.cells.at(shipyard.cell);
+
+        int fleetSize = state.availableShips[shipyard.id];
         if (fleetSize < requiredShips) {
             continue;
         }
 
-        Cell *bestCell = nullptr;
+        const auto &topology = state.board.topology();
+
+        const Cell *bestCell = nullptr;
         double bestScore = std::numeric_limits<double>::lowest();
 
-        for (auto &targetCell : state.board.cells) {
-            if (targetCell.shipyard != nullptr
-                || futureBoard.cells.at(targetCell).shipyard != nullptr
-                || usedCells.find(&targetCell) != usedCells.end()) {
+        for (int targetIndex : topology.cellsWithin(shipyard.cell, maxDistance)) {
+            const auto &targetCell = state.board.cells.at(targetIndex);
+
+            if (targetCell.shipyard != -1
+                || futureBoard.cells.at(targetCell).shipyard != -1
+                || usedCells.find(targetCell.index) != usedCells.end()) {
                 continue;
             }
 
-            int distance = targetCell.distanceTo(*shipyard->cell);
-            if (distance < minDistance || distance > maxDistance) {
+            if (topology.distance(targetIndex, shipyard.cell) < minDistance) {
                 continue;
             }
 
             double nearbyKore = 0.0;
+            for (int otherIndex : topology.cellsWithin(targetIndex, 8)) {
+                if (otherIndex != targetIndex) {
+                    nearbyKore += state.board.cells.kore(otherIndex);
+                }
+            }
+
             int nearbyShipyards = 0;
 
             int closestFriendly = std::numeric_limits<int>::max();
             int closestOpponent = std::numeric_limits<int>::max();
 
-            for (const auto &otherCell : state.board.cells) {
-                int distanceToOther = targetCell.distanceTo(otherCell);
-                if (distanceToOther == 0) {
-                    continue;
-                }
+            for (const auto &otherShipyard : state.board.shipyards) {
+                int distanceToOther = topology.distance(targetIndex, otherShipyard.cell);
 
-                if (distanceToOther <= 8) {
-                    nearbyKore += otherCell.kore;
+                if (distanceToOther <= maxDistance) {
+                    nearbyShipyards++;
                 }
 
-                if (otherCell.shipyard != nullptr) {
-                    if (distanceToOther <= maxDistance) {
-                        nearbyShipyards++;
-                    }
-
-                    if (otherCell.shipyard->player->id == state.board.me().id) {
-                        closestFriendly = std::min(closestFriendly, distanceToOther);
-                    } else {
-                        closestOpponent = std::min(closestFriendly, distanceToOther);
-                    }
+                if (otherShipyard.player == state.board.me().id) {
+                    closestFriendly = std::min(closestFriendly, distanceToOther);
+                } else {
+                    closestOpponent = std::min(closestFriendly, distanceToOther);
                 }
             }
 
@@ -99,49 +100,46 @@ void ExpandComponent::run(State &state) {
             continue;
         }
 
-        const auto &plans = _flightPlanDatabase.getConvertPlans(*shipyard->cell, *bestCell, fleetSize);
-        std::string bestPlan;
+        const auto &plans = _flightPlanDatabase.getConvertPlans(shipyardCell, *bestCell, fleetSize);
 
-        for (int i = 0; i < 10 && i < plans.size(); i++) {
-            Board testBoard = state.board.copy();
-            testBoard.shipyardsById[shipyard->id]->action = Action::launch(fleetSize, plans[i]);
+        int bestPlan = _executor.findFirst(std::min(10, (int) plans.size()), [&](int i) {
+            BoardArena::Scope arena;
+            Board testBoard = state.board.fork(arena.resource());
+            testBoard.findShipyard(shipyard.id)->action = Action::launch(fleetSize, plans[i]);
 
             for (int j = 0; j < 50; j++) {
                 testBoard.next();
             }
 
-            const auto &targetCell = testBoard.cells.at(*bestCell);
-            if (targetCell.shipyard != nullptr && targetCell.shipyard->player->id == state.board.me().id) {
-                bestPlan = plans[i];
-                break;
-            }
-        }
+            const auto *targetShipyard = testBoard.shipyardAt(testBoard.cells.at(*bestCell));
+            return targetShipyard != nullptr && targetShipyard->player == state.board.me().id;
+        });
 
-        if (!bestPlan.empty()) {
-            shipyard->action = Action::launch(fleetSize, bestPlan);
+        if (bestPlan != -1) {
+            shipyard.action = Action::launch(fleetSize, plans[bestPlan]);
 
             requiredShipyards--;
             if (requiredShipyards == 0) {
                 return;
             }
 
-            usedCells.insert(bestCell);
+            usedCells.insert(bestCell->index);
         }
     }
 }
 
-int ExpandComponent::getRequiredShipyards(const State &state) const {
-    int myCurrentShips = state.board.me().getShipCount();
+int ExpandComponent::getRequiredShipyards(State &state) const {
+    int myCurrentShips = state.board.getShipCount(state.board.me().id);
     if (myCurrentShips < 100) {
         return 0;
     }
 
     int maxSpawn = 0;
-    for (const auto &shipyard : state.board.me().shipyards) {
-        maxSpawn += shipyard->getSpawnMaximum();
+    for (const auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        maxSpawn += shipyard.getSpawnMaximum();
     }
 
-    int stepsLeft = state.board.config.episodeSteps - state.board.step;
+    int stepsLeft = state.board.config().episodeSteps - state.board.step;
     int scale;
     if (stepsLeft > 100) {
         scale = 15;
@@ -157,16 +155,13 @@ int ExpandComponent::getRequiredShipyards(const State &state) const {
         return 0;
     }
 
-    Board futureBoard = state.board.copy();
-    for (int i = 0; i < 50; i++) {
-        futureBoard.next();
-    }
+    const auto &futureBoard = state.getFuture(50)[50];
 
-    int myCurrentShipyards = state.board.me().shipyards.size();
-    int myFutureShipyards = futureBoard.me().shipyards.size();
-    int opponentFutureShipyards = futureBoard.opponent().shipyards.size();
+    int myCurrentShipyards = state.board.shipyardsOf(state.board.me().id).size();
+    int myFutureShipyards = futureBoard.shipyardsOf(futureBoard.me().id).size();
+    int opponentFutureShipyards = futureBoard.shipyardsOf(futureBoard.opponent().id).size();
 
-    int opponentCurrentShips = state.board.opponent().getShipCount();
+    int opponentCurrentShips = state.board.getShipCount(state.board.opponent().id);
 
     if (myFutureShipyards > opponentFutureShipyards && myCurrentShips < opponentCurrentShips) {
         return 0;
@@ -1,15 +1,16 @@
 #pragma once
 
+#include <strategy/Executor.h>
 #include <strategy/FlightPlanDatabase.h>
 #include <strategy/State.h>
 #include <strategy/StrategyComponent.h>
 
 class ExpandComponent : public StrategyComponent {
 public:
-    explicit ExpandComponent(FlightPlanDatabase &flightPlanDatabase);
+    ExpandComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor);
 
     void run(State &state) override;
 
 private:
-    [[nodiscard]] int getRequiredShipyards(const State &state) const;
+    [[nodiscard]] int getRequiredShipyards(State &state) const;
 };
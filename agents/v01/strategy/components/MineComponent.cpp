@@ -1,14 +1,18 @@
 #include <algorithm>
 #include <limits>
+#include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <core/Action.h>
+#include <core/BoardArena.h>
+#include <core/EntityId.h>
 #include <strategy/components/MineComponent.h>
 
-MineComponent::MineComponent(FlightPlanDatabase &flightPlanDatabase)
-        : StrategyComponent(flightPlanDatabase),
+MineComponent::MineComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : StrategyComponent(flightPlanDatabase, executor),
           _randomGenerator(std::random_device{}()) {}
 
 void MineComponent::run(State &state) {
@@ -17,14 +21,16 @@ void MineComponent::run(State &state) {
     int maxFleetSize = getMaxFleetSize(state.board);
     int maxSteps = 30;
 
-    std::unordered_map<std::string, std::vector<Action>> possibleActions;
+    std::unordered_map<EntityId, std::vector<Action>> possibleActions;
 
-    for (const auto &shipyard : state.board.me().shipyards) {
-        if (shipyard->action.has_value() || state.availableShips[shipyard->id] == 0) {
+    for (const auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        if (shipyard.action.has_value() || state.availableShips[shipyard.id] == 0) {
             continue;
         }
 
-        int fleetSize = state.availableShips[shipyard->id];
+        const auto &shipyardCell = state.board.cells.at(shipyard.cell);
+
+        int fleetSize = state.availableShips[shipyard.id];
         if (!force && fleetSize < minFleetSize) {
             continue;
         }
@@ -33,7 +39,7 @@ void MineComponent::run(State &state) {
             fleetSize = maxFleetSize;
         }
 
-        const auto &plans = _flightPlanDatabase.getTargetPlans(*shipyard->cell, *shipyard->cell, fleetSize);
+        const auto &plans = _flightPlanDatabase.getTargetPlans(shipyardCell, shipyardCell, fleetSize);
         if (plans.empty()) {
             continue;
         }
@@ -42,8 +48,8 @@ void MineComponent::run(State &state) {
         actions.reserve(plans.size());
 
         for (int i = 0; i <= maxSteps; i++) {
-            const auto &plansForSteps = _flightPlanDatabase.getTargetPlans(*shipyard->cell,
-                                                                           *shipyard->cell,
+            const auto &plansForSteps = _flightPlanDatabase.getTargetPlans(shipyardCell,
+                                                                           shipyardCell,
                                                                            fleetSize,
                                                                            i);
             for (const auto &plan : plansForSteps) {
@@ -52,7 +58,7 @@ void MineComponent::run(State &state) {
         }
 
         if (!actions.empty()) {
-            possibleActions[shipyard->id] = std::move(actions);
+            possibleActions[shipyard.id] = std::move(actions);
         }
     }
 
@@ -60,120 +66,151 @@ void MineComponent::run(State &state) {
         return;
     }
 
-    std::unordered_map<std::string, int> indices;
-    for (auto &[shipyardId, actions] : possibleActions) {
-        std::shuffle(actions.begin(), actions.end(), _randomGenerator);
-        indices[shipyardId] = 0;
+    std::unordered_set<EntityId> existingFleets;
+    for (const auto &fleet : state.board.fleetsOf(state.board.me().id)) {
+        existingFleets.insert(fleet.id);
     }
 
-    std::unordered_map<std::string, Action> bestActions;
-    double bestScore = std::numeric_limits<double>::lowest();
+    struct WorkerResult {
+        double bestScore = std::numeric_limits<double>::lowest();
+        std::unordered_map<EntityId, Action> bestActions;
+    };
 
-    double maxMs = state.board.config.actTimeout * 1000 - 250;
-    while (state.timer.millisecondsSinceStart() < maxMs) {
-        Board currentBoard = state.board.copy();
-        std::unordered_map<std::string, Action> currentActions;
+    int threadCount = _executor.getThreadCount();
 
-        for (auto &[shipyardId, actions] : possibleActions) {
-            if (indices[shipyardId] >= actions.size()) {
-                std::shuffle(actions.begin(), actions.end(), _randomGenerator);
-                indices[shipyardId] = 0;
-            }
+    // Every worker owns its random generator, candidate order, rollout boards and best result, so they share no
+    // mutable state until the results are reduced after all of them have finished
+    std::vector<std::mt19937::result_type> seeds(threadCount);
+    for (auto &seed : seeds) {
+        seed = _randomGenerator();
+    }
+
+    std::vector<WorkerResult> results(threadCount);
+
+    double maxMs = state.board.config().actTimeout * 1000 - 250;
 
-            const auto &currentAction = actions[indices[shipyardId]];
-            currentBoard.shipyardsById[shipyardId]->action = currentAction;
-            currentActions.insert({shipyardId, currentAction});
+    _executor.forEach(threadCount, [&](int worker) {
+        std::mt19937 randomGenerator(seeds[worker]);
+        auto workerActions = possibleActions;
+        auto &result = results[worker];
 
-            indices[shipyardId]++;
+        std::unordered_map<EntityId, int> indices;
+        for (auto &[shipyardId, actions] : workerActions) {
+            std::shuffle(actions.begin(), actions.end(), randomGenerator);
+            indices[shipyardId] = 0;
         }
 
-        std::unordered_set<std::string> existingFleets;
-        for (const auto &fleet : state.board.me().fleets) {
-            existingFleets.insert(fleet->id);
+        while (state.timer.millisecondsSinceStart() < maxMs) {
+            // Each rollout board lives in the arena of this thread, which is released as soon as the rollout ends
+            BoardArena::Scope arena;
+            Board currentBoard = state.board.fork(arena.resource());
+
+            std::unordered_map<EntityId, Action> currentActions;
+
+            for (auto &[shipyardId, actions] : workerActions) {
+                if (indices[shipyardId] >= actions.size()) {
+                    std::shuffle(actions.begin(), actions.end(), randomGenerator);
+                    indices[shipyardId] = 0;
+                }
+
+                const auto &currentAction = actions[indices[shipyardId]];
+                currentBoard.findShipyard(shipyardId)->action = currentAction;
+                currentActions.insert({shipyardId, currentAction});
+
+                indices[shipyardId]++;
+            }
+
+            auto currentScore = simulate(currentBoard, existingFleets, maxSteps);
+            if (currentScore.has_value() && *currentScore > result.bestScore) {
+                result.bestActions = std::move(currentActions);
+                result.bestScore = *currentScore;
+            }
         }
+    });
 
-        std::unordered_map<std::string, double> mineFleetsCargo;
-        std::unordered_map<std::string, bool> mineFleetsCloseToHome;
+    const WorkerResult *bestResult = &results[0];
+    for (const auto &result : results) {
+        if (result.bestScore > bestResult->bestScore) {
+            bestResult = &result;
+        }
+    }
 
-        double currentScore = 0.0;
-        bool goodPlan = true;
+    for (const auto &[shipyardId, action] : bestResult->bestActions) {
+        state.board.findShipyard(shipyardId)->action = action;
+    }
+}
 
-        for (int i = 0; i < maxSteps; i++) {
-            currentBoard.next();
+std::optional<double> MineComponent::simulate(Board &board,
+                                              const std::unordered_set<EntityId> &existingFleets,
+                                              int maxSteps) const {
+    std::unordered_map<EntityId, double> mineFleetsCargo;
+    std::unordered_map<EntityId, bool> mineFleetsCloseToHome;
 
-            if (i == 0) {
-                for (const auto &fleet : currentBoard.me().fleets) {
-                    if (existingFleets.find(fleet->id) == existingFleets.end()) {
-                        mineFleetsCargo[fleet->id] = fleet->kore;
-                        mineFleetsCloseToHome[fleet->id] = true;
-                    }
-                }
-            } else {
-                std::unordered_set<std::string> fleetsSeen;
-                for (const auto &fleet : currentBoard.me().fleets) {
-                    if (mineFleetsCargo.find(fleet->id) != mineFleetsCargo.end()) {
-                        fleetsSeen.insert(fleet->id);
-                        mineFleetsCargo[fleet->id] = fleet->kore;
-
-                        mineFleetsCloseToHome[fleet->id] = false;
-                        for (const auto &shipyard : currentBoard.me().shipyards) {
-                            if (fleet->cell->distanceTo(*shipyard->cell) == 1) {
-                                mineFleetsCloseToHome[fleet->id] = true;
-                                break;
-                            }
-                        }
-                    }
-                }
+    double score = 0.0;
+
+    for (int i = 0; i < maxSteps; i++) {
+        board.next();
 
-                auto it = mineFleetsCargo.begin();
-                while (it != mineFleetsCargo.end()) {
-                    if (fleetsSeen.find(it->first) == fleetsSeen.end()) {
-                        if (!mineFleetsCloseToHome[it->first]) {
-                            goodPlan = false;
+        if (i == 0) {
+            for (const auto &fleet : board.fleetsOf(board.me().id)) {
+                if (existingFleets.find(fleet.id) == existingFleets.end()) {
+                    mineFleetsCargo[fleet.id] = fleet.kore;
+                    mineFleetsCloseToHome[fleet.id] = true;
+                }
+            }
+        } else {
+            std::unordered_set<EntityId> fleetsSeen;
+            for (const auto &fleet : board.fleetsOf(board.me().id)) {
+                if (mineFleetsCargo.find(fleet.id) != mineFleetsCargo.end()) {
+                    fleetsSeen.insert(fleet.id);
+                    mineFleetsCargo[fleet.id] = fleet.kore;
+
+                    mineFleetsCloseToHome[fleet.id] = false;
+                    for (const auto &shipyard : board.shipyardsOf(board.me().id)) {
+                        if (board.topology().distance(fleet.cell, shipyard.cell) == 1) {
+                            mineFleetsCloseToHome[fleet.id] = true;
                             break;
                         }
-
-                        currentScore += it->second * ((double) maxSteps / (double) (i + 1));
-                        it = mineFleetsCargo.erase(it);
-                    } else {
-                        it++;
                     }
                 }
             }
-        }
 
-        if (!goodPlan) {
-            continue;
-        }
-
-        for (const auto &[fleetId, undeliveredCargo] : mineFleetsCargo) {
-            currentScore -= undeliveredCargo;
-        }
+            auto it = mineFleetsCargo.begin();
+            while (it != mineFleetsCargo.end()) {
+                if (fleetsSeen.find(it->first) == fleetsSeen.end()) {
+                    if (!mineFleetsCloseToHome[it->first]) {
+                        return std::nullopt;
+                    }
 
-        if (currentScore > bestScore) {
-            bestActions = currentActions;
-            bestScore = currentScore;
+                    score += it->second * ((double) maxSteps / (double) (i + 1));
+                    it = mineFleetsCargo.erase(it);
+                } else {
+                    it++;
+                }
+            }
         }
     }
 
-    for (const auto &[shipyardId, action] : bestActions) {
-        state.board.shipyardsById[shipyardId]->action = action;
+    for (const auto &[fleetId, undeliveredCargo] : mineFleetsCargo) {
+        score -= undeliveredCargo;
     }
+
+    return score;
 }
 
 bool MineComponent::shouldForceMining(const State &state) const {
     if (state.board.step < 50
-        || !state.board.me().fleets.empty()
-        || (state.board.me().kore >= state.board.config.spawnCost && state.savingForEnd)) {
+        || !state.board.fleetsOf(state.board.me().id).empty()
+        || (state.board.me().kore >= state.board.config().spawnCost && state.savingForEnd)) {
         return false;
     }
 
-    for (const auto &shipyard : state.board.me().shipyards) {
-        if (!shipyard->action.has_value()) {
+    for (const auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        if (!shipyard.action.has_value()) {
             continue;
         }
 
-        if (shipyard->action->type == ActionType::SPAWN && shipyard->action->ships > 0) {
+        if (shipyard.action->type == ActionType::SPAWN && shipyard.action->ships > 0) {
             return false;
         }
     }
@@ -184,8 +221,8 @@ bool MineComponent::shouldForceMining(const State &state) const {
 int MineComponent::getMinFleetSize(const Board &board) const {
     int minSize = std::numeric_limits<int>::max();
 
-    for (const auto &fleet : board.opponent().fleets) {
-        minSize = std::min(minSize, fleet->ships);
+    for (const auto &fleet : board.fleetsOf(board.opponent().id)) {
+        minSize = std::min(minSize, fleet.ships);
     }
 
     if (minSize == std::numeric_limits<int>::max()) {
@@ -197,8 +234,8 @@ int MineComponent::getMinFleetSize(const Board &board) const {
 
 int MineComponent::getMaxFleetSize(const Board &board) const {
     int maxSize = 0;
-    for (const auto &fleet : board.opponent().fleets) {
-        maxSize = std::max(maxSize, fleet->ships);
+    for (const auto &fleet : board.fleetsOf(board.opponent().id)) {
+        maxSize = std::max(maxSize, fleet.ships);
     }
 
     if (maxSize == 0) {
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <optional>
 #include <random>
+#include <unordered_set>
 
 #include <core/Board.h>
+#include <core/EntityId.h>
+#include <strategy/Executor.h>
 #include <strategy/FlightPlanDatabase.h>
 #include <strategy/State.h>
 #include <strategy/StrategyComponent.h>
@@ -11,7 +15,7 @@ class MineComponent : public StrategyComponent {
     std::mt19937 _randomGenerator;
 
 public:
-    explicit MineComponent(FlightPlanDatabase &flightPlanDatabase);
+    MineComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor);
 
     void run(State &state) override;
 
@@ -20,4 +24,12 @@ private:
 
     [[nodiscard]] int getMinFleetSize(const Board &board) const;
     [[nodiscard]] int getMaxFleetSize(const Board &board) const;
+
+    /**
+     * Advances the board by the given number of steps and scores the mining fleets launched on the first step.
+     * Returns nothing if a mining fleet is lost away from its shipyards.
+     */
+    [[nodiscard]] std::optional<double> simulate(Board &board,
+                                                 const std::unordered_set<EntityId> &existingFleets,
+                                                 int maxSteps) const;
 };
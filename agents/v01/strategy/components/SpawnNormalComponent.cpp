@@ -1,18 +1,18 @@
 #include <strategy/components/SpawnNormalComponent.h>
 
-SpawnNormalComponent::SpawnNormalComponent(FlightPlanDatabase &flightPlanDatabase)
-        : StrategyComponent(flightPlanDatabase) {}
+SpawnNormalComponent::SpawnNormalComponent(FlightPlanDatabase &flightPlanDatabase, Executor &executor)
+        : StrategyComponent(flightPlanDatabase, executor) {}
 
 void SpawnNormalComponent::run(State &state) {
     if (state.savingForEnd) {
         return;
     }
 
-    for (const auto &shipyard : state.board.me().shipyards) {
-        if (shipyard->action.has_value()) {
+    for (auto &shipyard : state.board.shipyardsOf(state.board.me().id)) {
+        if (shipyard.action.has_value()) {
             continue;
         }
 
-        spawnMax(state, *shipyard, true);
+        spawnMax(state, shipyard, true);
     }
 }
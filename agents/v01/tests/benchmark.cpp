@@ -1,8 +1,45 @@
+#include <string>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <tests/utilities.h>
 
+#include <core/BoardArena.h>
+#include <core/OccupancyTable.h>
+
 #include <strategy/FlightPlanDatabase.h>
+#include <strategy/FlightPlanTable.h>
+#include <strategy/Executor.h>
+
+struct BoardPhases {
+    static void koreMining(Board &board) {
+        board.turnResolutionKoreMining();
+    }
+
+    static void koreRegeneration(Board &board) {
+        board.turnResolutionKoreRegeneration();
+    }
+
+    template<int Size>
+    static void next(Board &board) {
+        board.nextSized<Size>();
+    }
+};
+
+std::vector<Board> createEpisodeBoards() {
+    std::vector<Board> boards;
+
+    for (const auto &id : {"36310051", "36854179", "36857057", "36857242", "36857473",
+                           "36857552", "36857623", "36857773", "36857827", "36858040"}) {
+        auto data = parseDataFile(std::string(id) + ".json");
+        for (std::size_t step = 0; step < data["steps"].size(); step++) {
+            boards.push_back(createBoard(data, step));
+        }
+    }
+
+    return boards;
+}
 
 void copy_36310051_50(benchmark::State &state) {
     auto data = parseDataFile("36310051.json");
@@ -22,6 +59,95 @@ void copy_36310051_250(benchmark::State &state) {
     }
 }
 
+void copy_36310051_250_arena(benchmark::State &state) {
+    auto data = parseDataFile("36310051.json");
+    auto board = createBoard(data, 249);
+
+    for (auto _ : state) {
+        BoardArena::Scope arena;
+        benchmark::DoNotOptimize(board.copy(arena.resource()));
+    }
+}
+
+void kore_mining_all_episodes(benchmark::State &state) {
+    auto boards = createEpisodeBoards();
+
+    for (auto _ : state) {
+        for (auto &board : boards) {
+            BoardPhases::koreMining(board);
+        }
+    }
+}
+
+void kore_regeneration_all_episodes(benchmark::State &state) {
+    auto boards = createEpisodeBoards();
+
+    for (auto _ : state) {
+        for (auto &board : boards) {
+            BoardPhases::koreRegeneration(board);
+        }
+    }
+}
+
+template<int Size>
+void next_all_episodes(benchmark::State &state) {
+    auto boards = createEpisodeBoards();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Board> currentBoards;
+        for (const auto &board : boards) {
+            currentBoards.push_back(board.copy());
+        }
+        state.ResumeTiming();
+
+        for (auto &board : currentBoards) {
+            BoardPhases::next<Size>(board);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * boards.size());
+}
+
+void next_all_episodes_dynamic_size(benchmark::State &state) {
+    next_all_episodes<CellMap::DYNAMIC_SIZE>(state);
+}
+
+void next_all_episodes_size_21(benchmark::State &state) {
+    next_all_episodes<21>(state);
+}
+
+void rollouts_36310051_250_executor(benchmark::State &state) {
+    auto data = parseDataFile("36310051.json");
+    auto board = createBoard(data, 249);
+
+    Executor executor(state.range(0));
+    int rollouts = 256;
+
+    for (auto _ : state) {
+        executor.forEach(rollouts, [&](int) {
+            Board currentBoard = board.fork();
+            for (int i = 0; i < 30; i++) {
+                currentBoard.next();
+            }
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations() * rollouts);
+}
+
+void load_convert_plans_text(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FlightPlanTable::loadText("data/convert-plans.txt", 21));
+    }
+}
+
+void load_convert_plans_binary(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FlightPlanTable::loadBinary("data/convert-plans.bin", 21));
+    }
+}
+
 void simulate_36310051_50_to_51(benchmark::State &state) {
     auto data = parseDataFile("36310051.json");
     auto board = createBoard(data, 49);
@@ -78,6 +204,32 @@ void simulate_36310051_250_to_300(benchmark::State &state) {
     }
 }
 
+void simulate_36310051_250_to_300_fork(benchmark::State &state) {
+    auto data = parseDataFile("36310051.json");
+    auto board = createBoard(data, 249);
+
+    for (auto _ : state) {
+        auto currentBoard = board.fork();
+        for (int i = 0; i < 50; i++) {
+            currentBoard = currentBoard.fork();
+            currentBoard.next();
+        }
+    }
+}
+
+void simulate_36310051_250_to_300_arena(benchmark::State &state) {
+    auto data = parseDataFile("36310051.json");
+    auto board = createBoard(data, 249);
+
+    for (auto _ : state) {
+        BoardArena::Scope arena;
+        auto currentBoard = board.fork(arena.resource());
+        for (int i = 0; i < 50; i++) {
+            currentBoard.next();
+        }
+    }
+}
+
 void simulate_36310051_250_to_300_no_copy(benchmark::State &state) {
     auto data = parseDataFile("36310051.json");
     auto board = createBoard(data, 249);
@@ -90,13 +242,33 @@ void simulate_36310051_250_to_300_no_copy(benchmark::State &state) {
     }
 }
 
+void occupancy_36310051_250_to_300(benchmark::State &state) {
+    auto data = parseDataFile("36310051.json");
+    auto board = createBoard(data, 249);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OccupancyTable(board, 50));
+    }
+}
+
 BENCHMARK(copy_36310051_50);
 BENCHMARK(copy_36310051_250);
+BENCHMARK(copy_36310051_250_arena);
+BENCHMARK(kore_mining_all_episodes);
+BENCHMARK(kore_regeneration_all_episodes);
+BENCHMARK(rollouts_36310051_250_executor)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(load_convert_plans_text);
+BENCHMARK(load_convert_plans_binary);
+BENCHMARK(next_all_episodes_dynamic_size);
+BENCHMARK(next_all_episodes_size_21);
 BENCHMARK(simulate_36310051_50_to_51);
 BENCHMARK(simulate_36310051_283_to_284);
 BENCHMARK(simulate_36310051_50_to_100);
 BENCHMARK(simulate_36310051_50_to_100_no_copy);
 BENCHMARK(simulate_36310051_250_to_300);
+BENCHMARK(simulate_36310051_250_to_300_fork);
+BENCHMARK(simulate_36310051_250_to_300_arena);
 BENCHMARK(simulate_36310051_250_to_300_no_copy);
+BENCHMARK(occupancy_36310051_250_to_300);
 
 BENCHMARK_MAIN();
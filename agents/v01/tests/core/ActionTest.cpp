@@ -53,3 +53,11 @@ TEST(ActionTest, ToStringLaunch) {
 
     EXPECT_EQ("LAUNCH_42_N5CE5S5W", action.toString());
 }
+
+TEST(ActionTest, Equality) {
+    EXPECT_EQ(Action::spawn(5), Action::parse("SPAWN_5"));
+    EXPECT_NE(Action::spawn(5), Action::spawn(6));
+    EXPECT_EQ(Action::launch(21, "N5S"), Action::parse("LAUNCH_21_N5S"));
+    EXPECT_NE(Action::launch(21, "N5S"), Action::launch(21, "N4S"));
+    EXPECT_NE(Action::launch(21, "N5S"), Action::launch(22, "N5S"));
+}
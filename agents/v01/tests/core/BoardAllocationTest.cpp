@@ -0,0 +1,78 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/Board.h>
+#include <tests/utilities.h>
+
+namespace {
+    std::atomic<bool> countAllocations = false;
+    std::atomic<int> allocations = 0;
+}
+
+void *operator new(std::size_t size) {
+    if (countAllocations) {
+        allocations++;
+    }
+
+    void *pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// Inlining the free() into callers of the replaced operator new trips -Wmismatched-new-delete on GCC
+[[gnu::noinline]] void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+TEST(BoardAllocationTest, Next) {
+    std::vector<Board> boards;
+    for (const auto &id : {"36310051", "36854179", "36857057"}) {
+        auto data = parseDataFile(std::string(id) + ".json");
+        for (std::size_t step = 0; step < data["steps"].size(); step++) {
+            boards.push_back(createBoard(data, step));
+        }
+    }
+
+    // The first pass grows the scratch buffers of the turn phases, the second one must reuse them. Each board takes
+    // one turn first, so its own buffers are detached from the source board and sized for the turn that is counted.
+    for (int pass = 0; pass < 2; pass++) {
+        for (const auto &board : boards) {
+            Board currentBoard = board.copy();
+            currentBoard.next();
+
+            allocations = 0;
+            countAllocations = true;
+            currentBoard.next();
+            countAllocations = false;
+
+            if (pass == 1) {
+                EXPECT_EQ(0, allocations) << "step=" << board.step;
+            }
+        }
+    }
+}
@@ -1,10 +1,20 @@
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 
+#include <core/Action.h>
 #include <core/Board.h>
+#include <core/BoardArena.h>
+#include <core/EntityHandle.h>
+#include <core/EntityId.h>
 #include <core/Player.h>
 #include <tests/utilities.h>
 
@@ -17,81 +27,159 @@ struct BoardTest : public testing::Test {
 
         assertBoardEquals(expected, actual);
 
-        for (const auto &player : actual.players) {
-            for (const auto &shipyard : player->shipyards) {
-                EXPECT_FALSE(shipyard->action.has_value());
+        for (const auto &shipyard : actual.shipyards) {
+            EXPECT_FALSE(shipyard.action.has_value());
+        }
+    }
+
+    void testNextAndUndo(const nlohmann::json &data, std::size_t step) {
+        Board board = createBoard(data, step);
+        board.setRecordUndo(true);
+
+        Board before = board.copy();
+        board.next();
+
+        Board after = board.copy();
+        board.next();
+
+        board.undo();
+        assertBoardIdentical(after, board);
+
+        board.undo();
+        assertBoardIdentical(before, board);
+        EXPECT_FALSE(board.canUndo());
+
+        board.next();
+        assertBoardIdentical(after, board);
+    }
+
+    void assertBoardIdentical(const Board &expected, const Board &actual) {
+        EXPECT_EQ(expected.step, actual.step);
+
+        ASSERT_EQ(expected.config().size, actual.config().size);
+        for (const auto &expectedCell : expected.cells) {
+            const auto &actualCell = actual.cells.at(expectedCell.index);
+            auto params = "cell=" + std::to_string(expectedCell.index);
+
+            EXPECT_EQ(expected.cells.kore(expectedCell), actual.cells.kore(actualCell)) << params;
+            EXPECT_EQ(expectedCell.shipyard, actualCell.shipyard) << params;
+            auto expectedFleets = expected.fleetsAt(expectedCell);
+            auto actualFleets = actual.fleetsAt(actualCell);
+            EXPECT_EQ(std::vector<int>(expectedFleets.begin(), expectedFleets.end()),
+                      std::vector<int>(actualFleets.begin(), actualFleets.end())) << params;
+        }
+
+        ASSERT_EQ(expected.players.size(), actual.players.size());
+        for (std::size_t i = 0; i < expected.players.size(); i++) {
+            EXPECT_EQ(expected.players[i].id, actual.players[i].id);
+            EXPECT_EQ(expected.players[i].kore, actual.players[i].kore);
+        }
+
+        ASSERT_EQ(expected.shipyards.size(), actual.shipyards.size());
+        for (std::size_t i = 0; i < expected.shipyards.size(); i++) {
+            const auto &expectedShipyard = expected.shipyards[i];
+            const auto &actualShipyard = actual.shipyards[i];
+            auto params = "shipyard=" + std::to_string(i);
+
+            EXPECT_EQ(expectedShipyard.id, actualShipyard.id) << params;
+            EXPECT_EQ(expectedShipyard.cell, actualShipyard.cell) << params;
+            EXPECT_EQ(expectedShipyard.player, actualShipyard.player) << params;
+            EXPECT_EQ(expectedShipyard.ships, actualShipyard.ships) << params;
+            EXPECT_EQ(expectedShipyard.turnsControlled, actualShipyard.turnsControlled) << params;
+
+            ASSERT_EQ(expectedShipyard.action.has_value(), actualShipyard.action.has_value()) << params;
+            if (expectedShipyard.action.has_value()) {
+                EXPECT_EQ(expectedShipyard.action->toString(), actualShipyard.action->toString()) << params;
             }
         }
+
+        ASSERT_EQ(expected.fleets.size(), actual.fleets.size());
+        for (std::size_t i = 0; i < expected.fleets.size(); i++) {
+            const auto &expectedFleet = expected.fleets[i];
+            const auto &actualFleet = actual.fleets[i];
+            auto params = "fleet=" + std::to_string(i);
+
+            EXPECT_EQ(expectedFleet.id, actualFleet.id) << params;
+            EXPECT_EQ(expectedFleet.cell, actualFleet.cell) << params;
+            EXPECT_EQ(expectedFleet.player, actualFleet.player) << params;
+            EXPECT_EQ(expectedFleet.kore, actualFleet.kore) << params;
+            EXPECT_EQ(expectedFleet.ships, actualFleet.ships) << params;
+            EXPECT_EQ(expectedFleet.direction, actualFleet.direction) << params;
+            EXPECT_EQ(expectedFleet.getRemainingFlightPlan().toString(),
+                      actualFleet.getRemainingFlightPlan().toString()) << params;
+        }
     }
 
     void assertBoardEquals(const Board &expected, const Board &actual) {
-        EXPECT_EQ(expected.config.episodeSteps, actual.config.episodeSteps);
-        EXPECT_EQ(expected.config.actTimeout, actual.config.actTimeout);
-        EXPECT_EQ(expected.config.runTimeout, actual.config.runTimeout);
-        EXPECT_EQ(expected.config.agentTimeout, actual.config.agentTimeout);
-        EXPECT_EQ(expected.config.startingKore, actual.config.startingKore);
-        ASSERT_EQ(expected.config.size, actual.config.size);
-        EXPECT_EQ(expected.config.spawnCost, actual.config.spawnCost);
-        EXPECT_EQ(expected.config.convertCost, actual.config.convertCost);
-        EXPECT_EQ(expected.config.regenRate, actual.config.regenRate);
-        EXPECT_EQ(expected.config.maxRegenCellKore, actual.config.maxRegenCellKore);
-        EXPECT_EQ(expected.config.randomSeed, actual.config.randomSeed);
+        EXPECT_EQ(expected.config().episodeSteps, actual.config().episodeSteps);
+        EXPECT_EQ(expected.config().actTimeout, actual.config().actTimeout);
+        EXPECT_EQ(expected.config().runTimeout, actual.config().runTimeout);
+        EXPECT_EQ(expected.config().agentTimeout, actual.config().agentTimeout);
+        EXPECT_EQ(expected.config().startingKore, actual.config().startingKore);
+        ASSERT_EQ(expected.config().size, actual.config().size);
+        EXPECT_EQ(expected.config().spawnCost, actual.config().spawnCost);
+        EXPECT_EQ(expected.config().convertCost, actual.config().convertCost);
+        EXPECT_EQ(expected.config().regenRate, actual.config().regenRate);
+        EXPECT_EQ(expected.config().maxRegenCellKore, actual.config().maxRegenCellKore);
+        EXPECT_EQ(expected.config().randomSeed, actual.config().randomSeed);
 
         EXPECT_EQ(expected.step, actual.step);
         EXPECT_EQ(expected.meIndex, actual.meIndex);
 
-        for (int y = 0; y < expected.config.size; y++) {
-            for (int x = 0; x < expected.config.size; x++) {
+        for (int y = 0; y < expected.config().size; y++) {
+            for (int x = 0; x < expected.config().size; x++) {
                 auto params = "x=" + std::to_string(x) + ", y=" + std::to_string(y);
-                EXPECT_NEAR(expected.cells.at(x, y).kore, actual.cells.at(x, y).kore, 0.001) << params;
+                double expectedKore = expected.cells.kore(expected.cells.at(x, y));
+                double actualKore = actual.cells.kore(actual.cells.at(x, y));
+                EXPECT_NEAR(expectedKore, actualKore, 0.001) << params;
             }
         }
 
         ASSERT_EQ(expected.players.size(), actual.players.size());
         for (std::size_t i = 0; i < expected.players.size(); i++) {
-            assertPlayerEquals(*expected.players[i], *actual.players[i], i);
+            assertPlayerEquals(expected, actual, i);
         }
     }
 
-    void assertPlayerEquals(const Player &expected, const Player &actual, std::size_t who) {
-        EXPECT_NEAR(expected.kore, actual.kore, 0.001) << "player=" + std::to_string(who);
+    void assertPlayerEquals(const Board &expected, const Board &actual, std::size_t who) {
+        EXPECT_NEAR(expected.players[who].kore, actual.players[who].kore, 0.001) << "player=" + std::to_string(who);
 
-        EXPECT_EQ(expected.shipyards.size(), actual.shipyards.size());
-        for (const auto &expectedShipyard : expected.shipyards) {
-            auto params = "player=" + std::to_string(who) + ", shipyard.id=" + expectedShipyard->id;
+        EXPECT_EQ(expected.shipyardsOf(who).size(), actual.shipyardsOf(who).size());
+        for (const auto &expectedShipyard : expected.shipyardsOf(who)) {
+            auto params = "player=" + std::to_string(who) + ", shipyard.id=" + expectedShipyard.id.toString();
             bool actualFound = false;
 
-            for (const auto &actualShipyard : actual.shipyards) {
-                if (expectedShipyard->cell->x != actualShipyard->cell->x
-                    || expectedShipyard->cell->y != actualShipyard->cell->y) {
+            for (const auto &actualShipyard : actual.shipyardsOf(who)) {
+                if (expectedShipyard.cell != actualShipyard.cell) {
                     continue;
                 }
 
                 actualFound = true;
 
-                EXPECT_EQ(expectedShipyard->ships, actualShipyard->ships) << params;
-                EXPECT_EQ(expectedShipyard->turnsControlled, actualShipyard->turnsControlled) << params;
+                EXPECT_EQ(expectedShipyard.ships, actualShipyard.ships) << params;
+                EXPECT_EQ(expectedShipyard.turnsControlled, actualShipyard.turnsControlled) << params;
             }
 
             EXPECT_TRUE(actualFound) << params;
         }
 
-        EXPECT_EQ(expected.fleets.size(), actual.fleets.size());
-        for (const auto &expectedFleet : expected.fleets) {
-            auto params = "player=" + std::to_string(who) + ", fleet.id=" + expectedFleet->id;
+        EXPECT_EQ(expected.fleetsOf(who).size(), actual.fleetsOf(who).size());
+        for (const auto &expectedFleet : expected.fleetsOf(who)) {
+            auto params = "player=" + std::to_string(who) + ", fleet.id=" + expectedFleet.id.toString();
             bool actualFound = false;
 
-            for (const auto &actualFleet : actual.fleets) {
-                if (expectedFleet->cell->x != actualFleet->cell->x || expectedFleet->cell->y != actualFleet->cell->y) {
+            for (const auto &actualFleet : actual.fleetsOf(who)) {
+                if (expectedFleet.cell != actualFleet.cell) {
                     continue;
                 }
 
                 actualFound = true;
 
-                EXPECT_NEAR(expectedFleet->kore, actualFleet->kore, 0.001) << params;
-                EXPECT_EQ(expectedFleet->ships, actualFleet->ships) << params;
-                EXPECT_EQ(expectedFleet->direction, actualFleet->direction) << params;
-                EXPECT_EQ(expectedFleet->flightPlan.toString(), actualFleet->flightPlan.toString()) << params;
+                EXPECT_NEAR(expectedFleet.kore, actualFleet.kore, 0.001) << params;
+                EXPECT_EQ(expectedFleet.ships, actualFleet.ships) << params;
+                EXPECT_EQ(expectedFleet.direction, actualFleet.direction) << params;
+                EXPECT_EQ(expectedFleet.getRemainingFlightPlan().toString(),
+                      actualFleet.getRemainingFlightPlan().toString()) << params;
             }
 
             EXPECT_TRUE(actualFound) << params;
@@ -109,6 +197,10 @@ TEST_P(BoardTest##id, Next) {
     testNext(episodeData##id, GetParam());                                             \
 }                                                                                      \
                                                                                        \
+TEST_P(BoardTest##id, NextAndUndo) {                                                   \
+    testNextAndUndo(episodeData##id, GetParam());                                      \
+}                                                                                      \
+                                                                                       \
 INSTANTIATE_TEST_SUITE_P(BoardTest,                                                    \
                          BoardTest##id,                                                \
                          testing::Range(0, (int) episodeData##id["steps"].size() - 1), \
@@ -130,3 +222,348 @@ CREATE_BOARD_TEST(36857827)
 CREATE_BOARD_TEST(36858040)
 
 #undef CREATE_BOARD_TEST
+
+TEST_F(BoardTest, FleetsAtInEntryOrder) {
+    Board board = createBoard(episodeData36310051, 249);
+
+    const Cell *emptyCell = nullptr;
+    for (const auto &cell : board.cells) {
+        if (!cell.hasFleets() && cell.shipyard == -1) {
+            emptyCell = &cell;
+            break;
+        }
+    }
+
+    ASSERT_NE(nullptr, emptyCell);
+    EXPECT_EQ(board.fleetsAt(*emptyCell).begin(), board.fleetsAt(*emptyCell).end());
+
+    std::vector<int> expected;
+    for (int i = 0; i < 3; i++) {
+        Fleet fleet = board.fleets[0];
+        fleet.cell = emptyCell->index;
+
+        board.addFleet(fleet);
+        expected.push_back(board.fleets.size() - 1);
+    }
+
+    const auto &cell = board.cells.at(emptyCell->index);
+    auto fleets = board.fleetsAt(cell);
+
+    EXPECT_TRUE(cell.hasMultipleFleets());
+    EXPECT_EQ(expected, std::vector<int>(fleets.begin(), fleets.end()));
+}
+
+TEST_F(BoardTest, EntityHandles) {
+    Board board = createBoard(episodeData36310051, 249);
+    ASSERT_FALSE(board.fleets.empty());
+
+    auto fleetHandle = board.handleOf(board.fleets[0]);
+    auto shipyardHandle = board.handleOf(board.shipyards[0]);
+
+    EXPECT_EQ(&board.fleets[0], board.getFleet(fleetHandle));
+    EXPECT_EQ(&board.shipyards[0], board.getShipyard(shipyardHandle));
+
+    Board copy = board.copy();
+    EXPECT_EQ(&copy.fleets[0], copy.getFleet(fleetHandle));
+    EXPECT_EQ(&copy.shipyards[0], copy.getShipyard(shipyardHandle));
+
+    Board other = createBoard(episodeData36310051, 249);
+    EXPECT_EQ(nullptr, other.getFleet(fleetHandle));
+    EXPECT_EQ(nullptr, other.getShipyard(shipyardHandle));
+}
+
+TEST_F(BoardTest, EntityHandlesStaleOnlyAfterChanges) {
+    bool testedChange = false;
+    bool testedNoChange = false;
+
+    for (std::size_t step = 0; step + 1 < episodeData36310051["steps"].size(); step++) {
+        Board board = createBoard(episodeData36310051, step);
+
+        std::vector<std::pair<EntityId, EntityHandle>> fleetHandles;
+        for (const auto &fleet : board.fleets) {
+            fleetHandles.emplace_back(fleet.id, board.handleOf(fleet));
+        }
+
+        std::size_t shipyardCount = board.shipyards.size();
+
+        board.next();
+
+        bool changed = board.shipyards.size() != shipyardCount || board.fleets.size() > fleetHandles.size();
+        for (const auto &[id, handle] : fleetHandles) {
+            changed = changed || board.findFleet(id) == nullptr;
+        }
+
+        for (const auto &[id, handle] : fleetHandles) {
+            if (changed) {
+                EXPECT_EQ(nullptr, board.getFleet(handle)) << "step=" << step;
+            } else {
+                ASSERT_NE(nullptr, board.getFleet(handle)) << "step=" << step;
+                EXPECT_EQ(id, board.getFleet(handle)->id) << "step=" << step;
+            }
+        }
+
+        if (!fleetHandles.empty()) {
+            testedChange = testedChange || changed;
+            testedNoChange = testedNoChange || !changed;
+        }
+    }
+
+    EXPECT_TRUE(testedChange);
+    EXPECT_TRUE(testedNoChange);
+}
+
+TEST_F(BoardTest, EntityHandlesStaleAfterLaunchUndone) {
+    Board board = createBoard(episodeData36310051, 249);
+    board.setRecordUndo(true);
+
+    std::size_t fleetCount = board.fleets.size();
+    auto &shipyard = *board.shipyardsOf(board.me().id).begin();
+    shipyard.ships = 2;
+    shipyard.action = Action::launch(2, "N");
+
+    board.next();
+    ASSERT_GT(board.fleets.size(), fleetCount);
+    auto handle = board.handleOf(board.fleets.back());
+
+    board.undo();
+    EXPECT_EQ(fleetCount, board.fleets.size());
+    EXPECT_EQ(nullptr, board.getFleet(handle));
+}
+
+TEST_F(BoardTest, EntityHandlesOfLaunchedFleetsStaleOnSource) {
+    Board board = createBoard(episodeData36310051, 249);
+
+    Board fork = board.fork();
+    auto &shipyard = *fork.shipyardsOf(fork.me().id).begin();
+    shipyard.ships = 2;
+    shipyard.action = Action::launch(2, "N");
+
+    fork.next();
+    ASSERT_GT(fork.fleets.size(), board.fleets.size());
+    auto handle = fork.handleOf(fork.fleets.back());
+
+    EXPECT_EQ(&fork.fleets.back(), fork.getFleet(handle));
+    EXPECT_EQ(nullptr, board.getFleet(handle));
+
+    // Even a handle that claims the generation of the source must stay within its entities
+    EXPECT_EQ(nullptr, board.getFleet({handle.index, board.handleOf(board.shipyards[0]).generation}));
+}
+
+TEST_F(BoardTest, SortShipyardsOfPlayer) {
+    Board board = createBoard(episodeData36310051, 249);
+    Board original = board.copy();
+    auto handle = board.handleOf(board.shipyards[0]);
+
+    int player = board.me().id;
+    board.sortShipyards(player, [](const Shipyard &a, const Shipyard &b) {
+        return a.turnsControlled < b.turnsControlled;
+    });
+
+    ASSERT_EQ(original.shipyards.size(), board.shipyards.size());
+    EXPECT_EQ(nullptr, board.getShipyard(handle));
+
+    std::vector<EntityId> expected;
+    for (const auto &shipyard : original.shipyards) {
+        if (shipyard.player == player) {
+            expected.push_back(shipyard.id);
+        }
+    }
+
+    std::stable_sort(expected.begin(), expected.end(), [&](EntityId a, EntityId b) {
+        return original.findShipyard(a)->turnsControlled < original.findShipyard(b)->turnsControlled;
+    });
+
+    std::vector<EntityId> actual;
+    for (std::size_t i = 0; i < board.shipyards.size(); i++) {
+        const auto &shipyard = board.shipyards[i];
+        EXPECT_EQ(static_cast<int>(i), board.cells.at(shipyard.cell).shipyard);
+
+        if (shipyard.player == player) {
+            actual.push_back(shipyard.id);
+        } else {
+            EXPECT_EQ(original.shipyards[i].id, shipyard.id);
+        }
+    }
+
+    EXPECT_GT(expected.size(), 1u);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(BoardTest, ForkSharesCellsUntilModified) {
+    Board board = createBoard(episodeData36310051, 249);
+    Board fork = board.fork();
+
+    EXPECT_TRUE(board.cells.isShared());
+    EXPECT_TRUE(fork.cells.isShared());
+
+    fork.next();
+
+    EXPECT_FALSE(board.cells.isShared());
+    EXPECT_FALSE(fork.cells.isShared());
+
+    assertBoardEquals(createBoard(episodeData36310051, 249), board);
+    assertBoardEquals(createBoard(episodeData36310051, 250), fork);
+}
+
+TEST_F(BoardTest, ForkCommit) {
+    Board board = createBoard(episodeData36310051, 249);
+
+    Board fork = board.fork();
+    fork.next();
+    fork.commit();
+
+    assertBoardEquals(createBoard(episodeData36310051, 250), board);
+}
+
+TEST_F(BoardTest, ForkDiscard) {
+    Board board = createBoard(episodeData36310051, 249);
+
+    Board fork = board.fork();
+    fork.next();
+    fork.discard();
+
+    assertBoardEquals(createBoard(episodeData36310051, 249), fork);
+
+    fork.next();
+
+    assertBoardEquals(createBoard(episodeData36310051, 250), fork);
+}
+
+TEST_F(BoardTest, ForkIntoArena) {
+    Board board = createBoard(episodeData36310051, 249);
+
+    BoardArena::Scope arena;
+    Board fork = board.fork(arena.resource());
+    fork.next();
+
+    EXPECT_EQ(arena.resource(), fork.resource());
+    EXPECT_EQ(arena.resource(), fork.cells.resource());
+    EXPECT_EQ(arena.resource(), fork.copy().resource());
+    EXPECT_EQ(std::pmr::get_default_resource(), board.resource());
+
+    assertBoardEquals(createBoard(episodeData36310051, 249), board);
+    assertBoardEquals(createBoard(episodeData36310051, 250), fork);
+}
+
+TEST_F(BoardTest, CommitFromArena) {
+    Board board = createBoard(episodeData36310051, 249);
+
+    {
+        BoardArena::Scope arena;
+        Board fork = board.fork(arena.resource());
+        fork.next();
+        fork.commit();
+
+        EXPECT_FALSE(board.cells.isShared());
+    }
+
+    EXPECT_EQ(std::pmr::get_default_resource(), board.resource());
+    assertBoardEquals(createBoard(episodeData36310051, 250), board);
+}
+
+TEST_F(BoardTest, CopiesAndForksStartWithoutUndoHistory) {
+    Board board = createBoard(episodeData36310051, 249);
+    board.setRecordUndo(true);
+    board.next();
+
+    Board copy = board.copy();
+    Board fork = board.fork();
+    EXPECT_FALSE(copy.canUndo());
+    EXPECT_FALSE(fork.canUndo());
+
+    fork.next();
+    fork.discard();
+    EXPECT_FALSE(fork.canUndo());
+    EXPECT_TRUE(board.canUndo());
+}
+
+TEST_F(BoardTest, CommitKeepsUndoHistory) {
+    Board board = createBoard(episodeData36310051, 249);
+    board.setRecordUndo(true);
+
+    Board before = board.copy();
+    board.next();
+    Board after = board.copy();
+
+    Board fork = board.fork();
+    fork.next();
+    fork.commit();
+
+    board.undo();
+    assertBoardIdentical(after, board);
+
+    board.undo();
+    assertBoardIdentical(before, board);
+    EXPECT_FALSE(board.canUndo());
+}
+
+TEST_F(BoardTest, CommitFromArenaDropsUndoHistory) {
+    Board board = createBoard(episodeData36310051, 249);
+    board.setRecordUndo(true);
+    board.next();
+
+    Board expected = board.copy();
+    expected.next();
+
+    {
+        BoardArena::Scope arena;
+        Board fork = board.fork(arena.resource());
+        fork.next();
+        fork.commit();
+    }
+
+    EXPECT_FALSE(board.canUndo());
+    assertBoardIdentical(expected, board);
+}
+
+TEST_F(BoardTest, ArenaReleasedByOutermostScope) {
+    void *first;
+
+    {
+        BoardArena::Scope outer;
+        first = outer.resource()->allocate(64);
+
+        {
+            BoardArena::Scope inner;
+            EXPECT_EQ(outer.resource(), inner.resource());
+        }
+
+        EXPECT_NE(first, outer.resource()->allocate(64));
+    }
+
+    BoardArena::Scope arena;
+    EXPECT_EQ(first, arena.resource()->allocate(64));
+}
+
+TEST_F(BoardTest, LazyKoreRegenerationMatchesEagerRegeneration) {
+    const nlohmann::json *episodes[] = {&episodeData36310051, &episodeData36854179, &episodeData36857057,
+                                        &episodeData36857242, &episodeData36857473, &episodeData36857552,
+                                        &episodeData36857623, &episodeData36857773, &episodeData36857827,
+                                        &episodeData36858040};
+
+    for (const auto *data : episodes) {
+        for (std::size_t step = 0; step + 1 < (*data)["steps"].size(); step += 50) {
+            Board lazy = createBoard(*data, step);
+            Board eager = lazy.copy();
+
+            while (lazy.step < lazy.config().episodeSteps) {
+                lazy.next();
+                eager.next();
+
+                // Writing every cell after every turn leaves exactly one regeneration to apply per cell and turn,
+                // which is the eager loop, while the lazy board is only read so its cells catch up many turns at once
+                for (int i = 0, iMax = eager.cells.count(); i < iMax; i++) {
+                    double eagerKore = eager.cells.kore(i);
+                    double lazyKore = std::as_const(lazy).cells.kore(i);
+
+                    std::uint64_t eagerBits;
+                    std::uint64_t lazyBits;
+                    std::memcpy(&eagerBits, &eagerKore, sizeof(double));
+                    std::memcpy(&lazyBits, &lazyKore, sizeof(double));
+
+                    ASSERT_EQ(eagerBits, lazyBits) << "from=" << step << ", step=" << lazy.step << ", cell=" << i;
+                }
+            }
+        }
+    }
+}
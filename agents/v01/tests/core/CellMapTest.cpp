@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/CellMap.h>
+#include <core/Configuration.h>
+
+namespace {
+    std::uint64_t bits(double value) {
+        std::uint64_t result;
+        std::memcpy(&result, &value, sizeof(double));
+        return result;
+    }
+}
+
+TEST(CellMapTest, LazyKoreRegenerationIsBitIdentical) {
+    Configuration config;
+    CellMap cells(config);
+
+    std::vector<double> eager(cells.count());
+    for (int i = 0; i < cells.count(); i++) {
+        eager[i] = i % 7 == 0 ? 0.0 : config.maxRegenCellKore * (i % 101) / 100.0 + i / 1000.0;
+        cells.kore(i) = eager[i];
+    }
+
+    for (int step = 0; step < 300; step++) {
+        std::vector<int> skippedCells;
+        for (int i = 0; i < cells.count(); i++) {
+            if ((i * 7 + step) % 11 == 0) {
+                skippedCells.push_back(i);
+            }
+        }
+
+        cells.regenerateKore(skippedCells);
+
+        for (int i = 0; i < cells.count(); i++) {
+            if ((i * 7 + step) % 11 != 0 && eager[i] < config.maxRegenCellKore) {
+                eager[i] += eager[i] * config.regenRate;
+            }
+        }
+
+        // Some cells are mined now and then, which brings them up to date
+        if (step % 13 == 0) {
+            for (int i = step % 5; i < cells.count(); i += 5) {
+                cells.kore(i) -= cells.kore(i) * 0.25;
+                eager[i] -= eager[i] * 0.25;
+            }
+        }
+
+        for (int i = 0; i < cells.count(); i++) {
+            ASSERT_EQ(bits(eager[i]), bits(std::as_const(cells).kore(i))) << "step=" << step << ", cell=" << i;
+        }
+    }
+}
+
+TEST(CellMapTest, CopiesRegenerateIndependently) {
+    Configuration config;
+    CellMap cells(config);
+    cells.kore(0) = 100.0;
+
+    CellMap copy = cells;
+    copy.regenerateKore({});
+
+    EXPECT_EQ(100.0, std::as_const(cells).kore(0));
+    EXPECT_EQ(100.0 + 100.0 * config.regenRate, std::as_const(copy).kore(0));
+
+    auto snapshot = copy.saveKore();
+    copy.regenerateKore({});
+    copy.kore(0) = 1.0;
+
+    copy.restoreKore(snapshot);
+    EXPECT_EQ(100.0 + 100.0 * config.regenRate, std::as_const(copy).kore(0));
+}
@@ -0,0 +1,29 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <core/EntityId.h>
+
+TEST(EntityIdTest, Parse) {
+    EntityId id = EntityId::parse("123-4");
+
+    EXPECT_EQ(123, id.getStep());
+    EXPECT_EQ(4, id.getCounter());
+}
+
+TEST(EntityIdTest, ParseInvalid) {
+    EXPECT_THROW((void) EntityId::parse("123"), std::invalid_argument);
+    EXPECT_THROW((void) EntityId::parse("-4"), std::invalid_argument);
+    EXPECT_THROW((void) EntityId::parse("123-"), std::invalid_argument);
+}
+
+TEST(EntityIdTest, ToString) {
+    EXPECT_EQ("0-1", EntityId::parse("0-1").toString());
+    EXPECT_EQ("400-12", EntityId::create(400, 12).toString());
+}
+
+TEST(EntityIdTest, Equality) {
+    EXPECT_EQ(EntityId::create(37, 2), EntityId::parse("37-2"));
+    EXPECT_NE(EntityId::create(37, 2), EntityId::parse("37-1"));
+    EXPECT_NE(EntityId::create(37, 2), EntityId::parse("2-37"));
+}
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <strategy/Executor.h>
+
+TEST(ExecutorTest, ForEach) {
+    Executor executor(4);
+    ASSERT_EQ(4, executor.getThreadCount());
+
+    std::vector<int> calls(100, 0);
+    executor.forEach(calls.size(), [&](int i) {
+        calls[i]++;
+    });
+
+    EXPECT_EQ(std::vector<int>(100, 1), calls);
+}
+
+TEST(ExecutorTest, ForEachNested) {
+    Executor executor(4);
+
+    std::atomic<int> calls = 0;
+    executor.forEach(8, [&](int) {
+        executor.forEach(8, [&](int) {
+            calls++;
+        });
+    });
+
+    EXPECT_EQ(64, calls);
+}
+
+TEST(ExecutorTest, ForEachRethrowsAfterAllTasks) {
+    for (int threadCount : {1, 4}) {
+        Executor executor(threadCount);
+
+        std::atomic<int> calls = 0;
+        EXPECT_THROW(executor.forEach(100, [&](int i) {
+            calls++;
+            if (i % 10 == 3) {
+                throw std::runtime_error("task " + std::to_string(i));
+            }
+        }), std::runtime_error);
+
+        EXPECT_EQ(100, calls) << "threadCount=" << threadCount;
+
+        calls = 0;
+        executor.forEach(100, [&](int) {
+            calls++;
+        });
+
+        EXPECT_EQ(100, calls) << "threadCount=" << threadCount;
+    }
+}
+
+TEST(ExecutorTest, Map) {
+    Executor executor(4);
+
+    auto results = executor.map(50, [](int i) {
+        return i * i;
+    });
+
+    ASSERT_EQ(50, results.size());
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(i * i, results[i]);
+    }
+}
+
+TEST(ExecutorTest, FindFirst) {
+    Executor executor(3);
+
+    EXPECT_EQ(7, executor.findFirst(20, [](int i) { return i >= 7; }));
+    EXPECT_EQ(-1, executor.findFirst(20, [](int i) { return i >= 20; }));
+    EXPECT_EQ(-1, executor.findFirst(0, [](int) { return true; }));
+}
+
+TEST(ExecutorTest, FindFirstSingleThreadStopsAtMatch) {
+    Executor executor(1);
+
+    int evaluated = 0;
+    EXPECT_EQ(3, executor.findFirst(10, [&](int i) {
+        evaluated++;
+        return i == 3;
+    }));
+
+    EXPECT_EQ(4, evaluated);
+}
@@ -0,0 +1,94 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <strategy/FlightPlanTable.h>
+
+TEST(FlightPlanTableTest, GetPlans) {
+    auto table = FlightPlanTable::loadText("data/convert-plans.txt", 21);
+
+    auto plans = table.getPlans(21, 2);
+    ASSERT_EQ(1, plans.size());
+    EXPECT_EQ("NC", plans[0].toString());
+
+    EXPECT_EQ(217, table.getPlans(21).size());
+    EXPECT_EQ("NC", table.getPlans(21)[0].toString());
+
+    EXPECT_TRUE(table.getPlans(21, 3).empty());
+    EXPECT_TRUE(table.getPlans(21, -1).empty());
+    EXPECT_TRUE(table.getPlans(21, 1000).empty());
+}
+
+TEST(FlightPlanTableTest, WithMaxLength) {
+    auto table = FlightPlanTable::loadText("data/convert-plans.txt", 21);
+    auto plans = table.getPlans(21);
+
+    EXPECT_TRUE(plans.withMaxLength(1).empty());
+    EXPECT_EQ(1, plans.withMaxLength(2).size());
+    EXPECT_EQ(plans.size(), plans.withMaxLength(100).size());
+
+    std::size_t previousSize = 0;
+    for (std::size_t maxLength = 0; maxLength < 20; maxLength++) {
+        auto prefix = plans.withMaxLength(maxLength);
+        EXPECT_GE(prefix.size(), previousSize);
+
+        for (auto plan : prefix) {
+            EXPECT_LE(plan.length, maxLength);
+        }
+
+        for (std::size_t i = prefix.size(); i < plans.size(); i++) {
+            EXPECT_GT(plans[i].length, maxLength);
+        }
+
+        previousSize = prefix.size();
+    }
+}
+
+TEST(FlightPlanTableTest, BinaryMatchesText) {
+    auto textTable = FlightPlanTable::loadText("data/convert-plans.txt", 21);
+    auto binaryTable = FlightPlanTable::loadBinary("data/convert-plans.bin", 21);
+
+    for (int index = 0; index < 21 * 21; index++) {
+        auto textPlans = textTable.getPlans(index);
+        auto binaryPlans = binaryTable.getPlans(index);
+
+        ASSERT_EQ(textPlans.size(), binaryPlans.size()) << "index=" << index;
+        for (std::size_t i = 0; i < textPlans.size(); i++) {
+            EXPECT_EQ(textPlans[i].toString(), binaryPlans[i].toString()) << "index=" << index;
+            EXPECT_EQ(textPlans[i].length, binaryPlans[i].length) << "index=" << index;
+        }
+
+        for (int steps = 0; steps < 50; steps++) {
+            auto textStepsPlans = textTable.getPlans(index, steps);
+            auto binaryStepsPlans = binaryTable.getPlans(index, steps);
+
+            ASSERT_EQ(textStepsPlans.size(), binaryStepsPlans.size()) << "index=" << index << ", steps=" << steps;
+            for (std::size_t i = 0; i < textStepsPlans.size(); i++) {
+                EXPECT_EQ(textStepsPlans[i].toString(), binaryStepsPlans[i].toString())
+                                    << "index=" << index << ", steps=" << steps;
+            }
+        }
+    }
+}
+
+TEST(FlightPlanTableTest, BoardSizeMismatch) {
+    EXPECT_THROW((void) FlightPlanTable::loadBinary("data/convert-plans.bin", 15), std::runtime_error);
+}
+
+TEST(FlightPlanTableTest, LoadFallsBackToTextForInvalidBinary) {
+    auto directory = std::filesystem::temp_directory_path() / "FlightPlanTableTest";
+    std::filesystem::create_directories(directory);
+    std::filesystem::copy_file("data/convert-plans.txt", directory / "convert-plans.txt",
+                               std::filesystem::copy_options::overwrite_existing);
+    std::ofstream(directory / "convert-plans.bin", std::ios::binary) << "stale";
+
+    auto textTable = FlightPlanTable::loadText("data/convert-plans.txt", 21);
+    auto table = FlightPlanTable::load(directory / "convert-plans.txt", 21);
+    std::filesystem::remove_all(directory);
+
+    for (int index = 0; index < 21 * 21; index++) {
+        ASSERT_EQ(textTable.getPlans(index).size(), table.getPlans(index).size()) << "index=" << index;
+    }
+}
@@ -1,3 +1,8 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <core/FlightPlan.h>
@@ -24,6 +29,72 @@ TEST(FlightPlanTest, Parse) {
     EXPECT_EQ(10, flightPlan[20].steps);
 }
 
+TEST(FlightPlanTest, ParseLongMoves) {
+    FlightPlan flightPlan = FlightPlan::parse("N65535S65536E12345678901234W");
+
+    ASSERT_EQ(7, flightPlan.size());
+    EXPECT_EQ(65535, flightPlan[1].steps);
+    EXPECT_EQ(65535, flightPlan[3].steps);
+    EXPECT_EQ(65535, flightPlan[5].steps);
+
+    EXPECT_EQ(65535, FlightPlanPart::move(1 << 20).steps);
+    EXPECT_THROW((void) FlightPlanPart::move(-1), std::invalid_argument);
+}
+
 TEST(FlightPlanTest, ToString) {
     EXPECT_EQ("0N1E2S3W4N5E6S7W8C9C10", FlightPlan::parse("0N1E2S3W4N5E6S7W8C9C10").toString());
 }
+
+TEST(FlightPlanTest, GetLength) {
+    EXPECT_EQ(0, FlightPlan::parse("").getLength());
+    EXPECT_EQ(22, FlightPlan::parse("0N1E2S3W4N5E6S7W8C9C10").getLength());
+}
+
+TEST(FlightPlanTest, Truncate) {
+    auto truncate = [](const std::string &flightPlan, int maxLength) {
+        FlightPlan parsedPlan = FlightPlan::parse(flightPlan);
+        parsedPlan.truncate(maxLength);
+        return parsedPlan.toString();
+    };
+
+    EXPECT_EQ("", truncate("N11E", 0));
+    EXPECT_EQ("N", truncate("N11E", 1));
+    EXPECT_EQ("N1", truncate("N11E", 2));
+    EXPECT_EQ("N11", truncate("N11E", 3));
+    EXPECT_EQ("N11E", truncate("N11E", 4));
+    EXPECT_EQ("N11E", truncate("N11E", 10));
+}
+
+TEST(FlightPlanTest, EncodeDecode) {
+    FlightPlan flightPlan = FlightPlan::parse("N5CE63S0W");
+
+    std::vector<std::uint8_t> parts;
+    for (const auto &part : flightPlan) {
+        parts.push_back(part.encode());
+    }
+
+    EncodedFlightPlan encodedPlan{parts.data(), static_cast<int>(parts.size()), flightPlan.getLength()};
+
+    EXPECT_EQ("N5CE63S0W", encodedPlan.toString());
+    EXPECT_THROW((void) FlightPlanPart::move(64).encode(), std::invalid_argument);
+}
+
+TEST(FlightPlanTest, PopFront) {
+    FlightPlan flightPlan = FlightPlan::parse("N5E");
+    flightPlan.pop_front();
+
+    ASSERT_EQ(2, flightPlan.size());
+    EXPECT_EQ(FlightPlanPartType::MOVE, flightPlan.front().type);
+    EXPECT_EQ("5E", flightPlan.toString());
+
+    FlightPlan copiedPlan = flightPlan;
+    copiedPlan.pop_front();
+
+    EXPECT_EQ("E", copiedPlan.toString());
+    EXPECT_EQ("5E", flightPlan.toString());
+}
+
+TEST(FlightPlanTest, Capacity) {
+    EXPECT_NO_THROW((void) FlightPlan::parse(std::string(FlightPlan::CAPACITY, 'N')));
+    EXPECT_THROW((void) FlightPlan::parse(std::string(FlightPlan::CAPACITY + 1, 'N')), std::length_error);
+}
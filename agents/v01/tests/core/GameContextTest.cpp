@@ -0,0 +1,27 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <core/Board.h>
+#include <core/Configuration.h>
+#include <core/GameContext.h>
+
+TEST(GameContextTest, RuleTables) {
+    auto context = GameContext::create(Configuration());
+
+    for (int ships = 1; ships <= 5000; ships++) {
+        EXPECT_EQ(std::min(std::log(ships) / 20.0, 0.99), context->getCollectionRate(ships)) << ships;
+        EXPECT_EQ((int) std::floor(2 * std::log(ships)) + 1, context->getMaxFlightPlanLength(ships)) << ships;
+    }
+}
+
+TEST(GameContextTest, SharedByCopies) {
+    auto context = GameContext::create(Configuration());
+    Board board(context);
+
+    Board copy = board.copy();
+
+    EXPECT_EQ(&board.context(), &copy.context());
+    EXPECT_EQ(3, context.use_count());
+}
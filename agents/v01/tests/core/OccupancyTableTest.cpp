@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/Board.h>
+#include <core/OccupancyTable.h>
+#include <tests/utilities.h>
+
+namespace {
+    const char *EPISODES[] = {"36310051.json", "36854179.json", "36857057.json", "36857242.json", "36857473.json",
+                              "36857552.json", "36857623.json", "36857773.json", "36857827.json", "36858040.json"};
+
+    template<typename Test>
+    void forEachBoard(Test test) {
+        for (const auto *episode : EPISODES) {
+            auto data = parseDataFile(episode);
+
+            for (std::size_t step = 0; step + 1 < data["steps"].size(); step += 10) {
+                test(createBoard(data, step), std::string(episode) + "@" + std::to_string(step));
+            }
+        }
+    }
+}
+
+TEST(OccupancyTableTest, ExactStepsMatchSimulation) {
+    int totalExactSteps = 0;
+
+    forEachBoard([&](Board board, const std::string &params) {
+        OccupancyTable table(board, OccupancyTable::MAX_HORIZON);
+        totalExactSteps += table.getExactSteps();
+
+        for (int step = 1; step <= table.getExactSteps(); step++) {
+            board.next();
+
+            std::vector<std::tuple<int, int, int, int>> expected;
+            for (const auto &fleet : board.fleets) {
+                expected.emplace_back(fleet.cell, fleet.id.value, fleet.player, fleet.ships);
+            }
+
+            std::vector<std::tuple<int, int, int, int>> actual;
+            for (const auto &occupant : table.at(step)) {
+                const auto &fleet = table.getFleet(occupant.fleet);
+                EXPECT_TRUE(occupant.certain) << params;
+                actual.emplace_back(occupant.cell, fleet.id.value, fleet.player, fleet.ships);
+            }
+
+            std::sort(expected.begin(), expected.end());
+            std::sort(actual.begin(), actual.end());
+            EXPECT_EQ(expected, actual) << params << ", step=" << step;
+
+            for (const auto &cell : board.cells) {
+                EXPECT_EQ(cell.shipyard != -1, table.hasShipyard(step, cell.index)) << params << ", step=" << step;
+
+                bool adjacent = false;
+                for (const auto &fleet : board.fleetsOf(board.opponent().id)) {
+                    adjacent |= board.topology().distance(cell.index, fleet.cell) == 1;
+                }
+
+                EXPECT_EQ(adjacent, table.isAdjacentToOpponent(step, cell.index, board.me().id)) << params;
+            }
+        }
+    });
+
+    EXPECT_GT(totalExactSteps, 0);
+}
+
+TEST(OccupancyTableTest, PossibleEntriesCoverSimulation) {
+    forEachBoard([](Board board, const std::string &params) {
+        OccupancyTable table(board, OccupancyTable::MAX_HORIZON);
+
+        for (int step = 1; step <= table.getHorizon(); step++) {
+            board.next();
+
+            for (const auto &occupant : table.at(step)) {
+                if (!occupant.certain) {
+                    continue;
+                }
+
+                const auto &trackedFleet = table.getFleet(occupant.fleet);
+                const auto *fleet = board.findFleet(trackedFleet.id);
+
+                ASSERT_NE(nullptr, fleet) << params << ", step=" << step;
+                EXPECT_EQ(occupant.cell, fleet->cell) << params << ", step=" << step;
+                EXPECT_EQ(trackedFleet.ships, fleet->ships) << params << ", step=" << step;
+            }
+
+            for (const auto &fleet : board.fleets) {
+                if (table.findFleet(fleet.id) == nullptr) {
+                    continue;
+                }
+
+                auto occupants = table.at(step, fleet.cell);
+                bool found = std::any_of(occupants.begin(), occupants.end(), [&](const auto &occupant) {
+                    return table.getFleet(occupant.fleet).id == fleet.id;
+                });
+
+                EXPECT_TRUE(found) << params << ", step=" << step;
+            }
+
+            for (const auto &cell : board.cells) {
+                if (!table.isCertain(step, cell.index)) {
+                    continue;
+                }
+
+                std::vector<int> expected;
+                for (int fleet : board.fleetsAt(cell)) {
+                    expected.push_back(board.fleets[fleet].id.value);
+                }
+
+                std::vector<int> actual;
+                for (const auto &occupant : table.at(step, cell.index)) {
+                    actual.push_back(table.getFleet(occupant.fleet).id.value);
+                }
+
+                EXPECT_EQ(expected, actual) << params << ", step=" << step;
+                EXPECT_EQ(cell.shipyard != -1, table.hasShipyard(step, cell.index)) << params << ", step=" << step;
+            }
+        }
+    });
+}
+
+TEST(OccupancyTableTest, ArrivalAndInterceptSteps) {
+    forEachBoard([](Board board, const std::string &params) {
+        OccupancyTable table(board, 20);
+
+        struct Query {
+            EntityId fleet;
+            int cell;
+            int arrivalStep;
+            int interceptStep;
+        };
+
+        std::vector<Query> queries;
+        for (const auto &fleet : board.fleets) {
+            int cell = fleet.trajectory.positionAt(5);
+            queries.push_back({fleet.id,
+                               cell,
+                               table.getArrivalStep(fleet.id, cell),
+                               table.getInterceptStep(fleet.id, cell)});
+        }
+
+        for (int step = 1; step <= table.getHorizon(); step++) {
+            board.next();
+
+            for (const auto &query : queries) {
+                const auto *fleet = board.findFleet(query.fleet);
+                const auto *shipyard = board.shipyardAt(board.cells.at(query.cell));
+
+                bool arrived = (fleet != nullptr && fleet->cell == query.cell)
+                               || (fleet == nullptr && shipyard != nullptr && query.arrivalStep == step);
+
+                if (query.arrivalStep > 0 && step < query.arrivalStep) {
+                    EXPECT_FALSE(fleet != nullptr && fleet->cell == query.cell) << params << ", step=" << step;
+                } else if (query.arrivalStep == step) {
+                    EXPECT_TRUE(arrived) << params << ", step=" << step;
+                } else if (query.arrivalStep == OccupancyTable::NEVER) {
+                    EXPECT_FALSE(fleet != nullptr && fleet->cell == query.cell) << params << ", step=" << step;
+                }
+
+                if (query.interceptStep == step) {
+                    ASSERT_NE(nullptr, fleet) << params << ", step=" << step;
+                    EXPECT_LE(board.topology().distance(query.cell, fleet->cell), step) << params;
+                }
+            }
+        }
+
+        for (const auto &query : queries) {
+            EXPECT_TRUE(query.arrivalStep == OccupancyTable::UNKNOWN || query.arrivalStep == OccupancyTable::NEVER
+                        || query.arrivalStep <= 5) << params;
+            EXPECT_TRUE(query.interceptStep == OccupancyTable::UNKNOWN || query.interceptStep == OccupancyTable::NEVER
+                        || query.interceptStep <= 3) << params;
+        }
+    });
+}
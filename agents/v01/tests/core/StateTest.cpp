@@ -0,0 +1,129 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/Action.h>
+#include <core/Board.h>
+#include <strategy/State.h>
+#include <tests/utilities.h>
+
+TEST(StateTest, Future) {
+    auto data = parseDataFile("36310051.json");
+    Board board = createBoard(data, 249);
+    State state(board);
+
+    const auto &future = state.getFuture(10);
+    ASSERT_LE(11, future.size());
+
+    Board expected = board.copy();
+    for (int i = 1; i <= 10; i++) {
+        expected.next();
+
+        EXPECT_EQ(expected.step, future[i].step);
+        EXPECT_EQ(expected.fleets.size(), future[i].fleets.size());
+        EXPECT_EQ(expected.getShipCount(expected.me().id), future[i].getShipCount(future[i].me().id));
+        EXPECT_EQ(expected.getShipCount(expected.opponent().id), future[i].getShipCount(future[i].opponent().id));
+    }
+}
+
+TEST(StateTest, FutureReusedUntilActionsChange) {
+    auto data = parseDataFile("36310051.json");
+    Board board = createBoard(data, 249);
+    State state(board);
+
+    (void) state.getFuture(20);
+
+    int nextCalls = Board::NEXT_CALLS;
+    (void) state.getFuture(10);
+    (void) state.getFuture(20);
+    EXPECT_EQ(nextCalls, Board::NEXT_CALLS);
+
+    (void) state.getFuture(25);
+    EXPECT_EQ(nextCalls + 5, Board::NEXT_CALLS);
+
+    for (auto &shipyard : board.shipyardsOf(board.me().id)) {
+        shipyard.action = Action::spawn(1);
+        break;
+    }
+
+    Board expected = board.copy();
+    expected.next();
+
+    const auto &future = state.getFuture(10);
+    EXPECT_EQ(nextCalls + 16, Board::NEXT_CALLS);
+    EXPECT_EQ(11, future.size());
+    EXPECT_EQ(expected.getShipCount(expected.me().id), future[1].getShipCount(future[1].me().id));
+    EXPECT_EQ(expected.me().kore, future[1].me().kore);
+}
+
+TEST(StateTest, ContinueFuture) {
+    auto data = parseDataFile("36310051.json");
+    Board previousBoard = createBoard(data, 100);
+    State previousState(previousBoard);
+    (void) previousState.getFuture(10);
+
+    Board board = createBoard(data, 101);
+    for (auto &shipyard : board.shipyards) {
+        shipyard.action.reset();
+    }
+
+    State state(board);
+    state.continueFuture(previousState.releaseFuture());
+
+    int nextCalls = Board::NEXT_CALLS;
+    const auto &future = state.getFuture(10);
+    EXPECT_EQ(nextCalls + 1, Board::NEXT_CALLS);
+    EXPECT_EQ(102, future[1].step);
+    EXPECT_DOUBLE_EQ(0.9, state.getFutureReuseRatio());
+}
+
+TEST(StateTest, ContinueFutureReordered) {
+    auto data = parseDataFile("36310051.json");
+    Board previousBoard = createBoard(data, 100);
+    State previousState(previousBoard);
+    (void) previousState.getFuture(10);
+
+    Board board = createBoard(data, 101);
+    for (auto &shipyard : board.shipyards) {
+        shipyard.action.reset();
+    }
+
+    for (const auto &player : board.players) {
+        board.sortShipyards(player.id, [](const Shipyard &a, const Shipyard &b) { return b.id.value < a.id.value; });
+    }
+
+    std::vector<Fleet> fleets(board.fleets.rbegin(), board.fleets.rend());
+    board.fleets.clear();
+    for (int i = 0, iMax = board.cells.count(); i < iMax; i++) {
+        board.cells.at(i).firstFleet = -1;
+        board.cells.at(i).lastFleet = -1;
+    }
+
+    for (auto &fleet : fleets) {
+        (void) board.addFleet(std::move(fleet));
+    }
+
+    State state(board);
+    state.continueFuture(previousState.releaseFuture());
+
+    int nextCalls = Board::NEXT_CALLS;
+    (void) state.getFuture(10);
+    EXPECT_EQ(nextCalls + 1, Board::NEXT_CALLS);
+    EXPECT_DOUBLE_EQ(0.9, state.getFutureReuseRatio());
+}
+
+TEST(StateTest, ContinueFutureMismatch) {
+    auto data = parseDataFile("36310051.json");
+    Board previousBoard = createBoard(data, 249);
+    State previousState(previousBoard);
+    (void) previousState.getFuture(10);
+
+    Board board = createBoard(data, 251);
+    State state(board);
+    state.continueFuture(previousState.releaseFuture());
+
+    int nextCalls = Board::NEXT_CALLS;
+    (void) state.getFuture(10);
+    EXPECT_EQ(nextCalls + 10, Board::NEXT_CALLS);
+    EXPECT_EQ(0.0, state.getFutureReuseRatio());
+}
@@ -0,0 +1,53 @@
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include <core/Direction.h>
+#include <core/Topology.h>
+
+TEST(TopologyTest, Distance) {
+    Topology topology(21);
+
+    EXPECT_EQ(0, topology.distance(topology.cellToIndex(3, 4), topology.cellToIndex(3, 4)));
+    EXPECT_EQ(7, topology.distance(topology.cellToIndex(3, 4), topology.cellToIndex(6, 8)));
+    EXPECT_EQ(2, topology.distance(topology.cellToIndex(0, 0), topology.cellToIndex(20, 20)));
+    EXPECT_EQ(20, topology.distance(topology.cellToIndex(0, 0), topology.cellToIndex(10, 10)));
+    EXPECT_EQ(20, topology.distance(topology.cellToIndex(0, 0), topology.cellToIndex(11, 11)));
+}
+
+TEST(TopologyTest, Neighbor) {
+    Topology topology(21);
+
+    int cell = topology.cellToIndex(0, 20);
+
+    EXPECT_EQ(topology.cellToIndex(0, 0), topology.neighbor(cell, Direction::NORTH));
+    EXPECT_EQ(topology.cellToIndex(1, 20), topology.neighbor(cell, Direction::EAST));
+    EXPECT_EQ(topology.cellToIndex(0, 19), topology.neighbor(cell, Direction::SOUTH));
+    EXPECT_EQ(topology.cellToIndex(20, 20), topology.neighbor(cell, Direction::WEST));
+}
+
+TEST(TopologyTest, CellsWithin) {
+    Topology topology(21);
+
+    int cell = topology.cellToIndex(1, 2);
+
+    EXPECT_EQ(0, topology.cellsWithin(cell, -1).size());
+    EXPECT_EQ(1, topology.cellsWithin(cell, 0).size());
+    EXPECT_EQ(cell, *topology.cellsWithin(cell, 0).begin());
+    EXPECT_EQ(145, topology.cellsWithin(cell, 8).size());
+    EXPECT_EQ(441, topology.cellsWithin(cell, 20).size());
+    EXPECT_EQ(441, topology.cellsWithin(cell, 100).size());
+
+    std::set<int> unique;
+    for (int other : topology.cellsWithin(cell, 8)) {
+        EXPECT_LE(topology.distance(cell, other), 8);
+        unique.insert(other);
+    }
+
+    EXPECT_EQ(145, unique.size());
+}
+
+TEST(TopologyTest, Get) {
+    EXPECT_EQ(Topology::get(21), Topology::get(21));
+    EXPECT_EQ(15, Topology::get(15)->getSize());
+}
@@ -0,0 +1,91 @@
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <core/Board.h>
+#include <core/Direction.h>
+#include <core/EntityId.h>
+#include <core/FlightPlan.h>
+#include <core/Topology.h>
+#include <core/Trajectory.h>
+#include <tests/utilities.h>
+
+TEST(TrajectoryTest, PositionAt) {
+    Topology topology(21);
+    Trajectory trajectory(topology.cellToIndex(0, 0), Direction::SOUTH, FlightPlan::parse("N2E3"), 21);
+
+    EXPECT_EQ(topology.cellToIndex(0, 0), trajectory.positionAt(0));
+    EXPECT_EQ(topology.cellToIndex(0, 1), trajectory.positionAt(1));
+    EXPECT_EQ(topology.cellToIndex(0, 3), trajectory.positionAt(3));
+    EXPECT_EQ(topology.cellToIndex(1, 3), trajectory.positionAt(4));
+    EXPECT_EQ(topology.cellToIndex(4, 3), trajectory.positionAt(7));
+    EXPECT_EQ(topology.cellToIndex(5, 3), trajectory.positionAt(8));
+    EXPECT_EQ(topology.cellToIndex(3, 3), trajectory.positionAt(27));
+
+    EXPECT_EQ(Direction::NORTH, trajectory.advance());
+    EXPECT_EQ(topology.cellToIndex(0, 1), trajectory.positionAt(0));
+    EXPECT_EQ(topology.cellToIndex(1, 3), trajectory.positionAt(3));
+
+    for (int i = 0; i < 3; i++) {
+        trajectory.advance();
+    }
+
+    EXPECT_EQ(Direction::EAST, trajectory.advance());
+    EXPECT_EQ(-1, trajectory.stepsUntilConvert());
+}
+
+TEST(TrajectoryTest, Convert) {
+    Trajectory trajectory(0, Direction::NORTH, FlightPlan::parse("E2C0S"), 21);
+
+    EXPECT_EQ(3, trajectory.stepsUntilConvert());
+    EXPECT_FALSE(trajectory.convertsNext());
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(Direction::EAST, trajectory.advance());
+    }
+
+    EXPECT_EQ(0, trajectory.stepsUntilConvert());
+    EXPECT_TRUE(trajectory.convertsNext());
+
+    // A fleet that fails to convert carries on with the rest of its plan in the same step
+    EXPECT_EQ(Direction::EAST, trajectory.advance());
+    EXPECT_EQ(Direction::SOUTH, trajectory.advance());
+    EXPECT_FALSE(trajectory.convertsNext());
+    EXPECT_EQ(-1, trajectory.stepsUntilConvert());
+}
+
+TEST(TrajectoryTest, LongMoves) {
+    Topology topology(21);
+    Trajectory trajectory(topology.cellToIndex(0, 0), Direction::NORTH, FlightPlan::parse("N65535E"), 21);
+
+    EXPECT_EQ(topology.cellToIndex(0, 16), trajectory.positionAt(100));
+    EXPECT_EQ(Direction::NORTH, trajectory.advance());
+    EXPECT_EQ(Direction::NORTH, trajectory.advance());
+}
+
+TEST(TrajectoryTest, MatchesSimulation) {
+    auto data = parseDataFile("36310051.json");
+
+    for (std::size_t step = 0; step + 1 < data["steps"].size(); step += 10) {
+        Board board = createBoard(data, step);
+
+        std::vector<std::pair<EntityId, Trajectory>> trajectories;
+        for (const auto &fleet : board.fleets) {
+            trajectories.emplace_back(fleet.id, fleet.trajectory);
+        }
+
+        for (int k = 1; k <= 20; k++) {
+            board.next();
+
+            for (const auto &[id, trajectory] : trajectories) {
+                const auto *fleet = board.findFleet(id);
+                if (fleet != nullptr) {
+                    EXPECT_EQ(trajectory.positionAt(k), fleet->cell) << "step=" << step << ", k=" << k;
+                }
+            }
+        }
+    }
+}
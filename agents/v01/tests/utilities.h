@@ -2,7 +2,6 @@
 
 #include <cstddef>
 #include <fstream>
-#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -13,63 +12,59 @@
 #include <core/Board.h>
 #include <core/Cell.h>
 #include <core/Configuration.h>
+#include <core/EntityId.h>
 #include <core/Fleet.h>
 #include <core/FlightPlan.h>
+#include <core/GameContext.h>
 #include <core/Player.h>
 #include <core/Shipyard.h>
 
-nlohmann::json parseDataFile(const std::string &dataFile) {
+inline nlohmann::json parseDataFile(const std::string &dataFile) {
     std::ifstream stream("test-data/" + dataFile, std::ios::in);
     return nlohmann::json::parse(stream);
 }
 
-Cell *indexToCell(Board &board, int index) {
-    return &board.cells.at(index % board.config.size, board.config.size - index / board.config.size - 1);
+inline int indexToCell(Board &board, int index) {
+    return board.cells.at(index % board.config().size, board.config().size - index / board.config().size - 1).index;
 }
 
-void addPlayer(Board &board, const nlohmann::json &playerData, const nlohmann::json &actionData, int id) {
-    auto player = std::make_unique<Player>();
-    player->id = id;
-    player->kore = playerData[0];
+inline void addPlayer(Board &board, const nlohmann::json &playerData, const nlohmann::json &actionData, int id) {
+    Player player;
+    player.id = id;
+    player.kore = playerData[0];
 
     for (const auto &item : playerData[1].items()) {
-        auto shipyard = std::make_unique<Shipyard>();
-        shipyard->id = item.key();
-        shipyard->cell = indexToCell(board, item.value()[0]);
-        shipyard->player = player.get();
-        shipyard->ships = item.value()[1];
-        shipyard->turnsControlled = item.value()[2];
-
-        if (actionData.contains(shipyard->id)) {
-            shipyard->action = Action::parse(actionData[shipyard->id]);
+        Shipyard shipyard;
+        shipyard.id = EntityId::parse(item.key());
+        shipyard.cell = indexToCell(board, item.value()[0]);
+        shipyard.player = id;
+        shipyard.ships = item.value()[1];
+        shipyard.turnsControlled = item.value()[2];
+
+        if (actionData.contains(item.key())) {
+            shipyard.action = Action::parse(actionData[item.key()]);
         }
 
-        board.shipyardsById[shipyard->id] = shipyard.get();
-
-        shipyard->cell->shipyard = shipyard.get();
-        player->shipyards.push_back(std::move(shipyard));
+        board.addShipyard(std::move(shipyard));
     }
 
     for (const auto &item : playerData[2].items()) {
-        auto fleet = std::make_unique<Fleet>();
-        fleet->id = item.key();
-        fleet->cell = indexToCell(board, item.value()[0]);
-        fleet->player = player.get();
-        fleet->kore = item.value()[1];
-        fleet->ships = item.value()[2];
-        fleet->direction = item.value()[3];
-        fleet->flightPlan = FlightPlan::parse(item.value()[4]);
-
-        board.fleetsById[fleet->id] = fleet.get();
-
-        fleet->cell->fleets.push_back(fleet.get());
-        player->fleets.push_back(std::move(fleet));
+        Fleet fleet;
+        fleet.id = EntityId::parse(item.key());
+        fleet.cell = indexToCell(board, item.value()[0]);
+        fleet.player = id;
+        fleet.kore = item.value()[1];
+        fleet.ships = item.value()[2];
+        fleet.direction = item.value()[3];
+        fleet.flightPlan = FlightPlan::parse(item.value()[4].get<std::string>());
+
+        board.addFleet(std::move(fleet));
     }
 
-    board.players.push_back(std::move(player));
+    board.players.push_back(player);
 }
 
-Board createBoard(const nlohmann::json &data, std::size_t step) {
+inline Board createBoard(const nlohmann::json &data, std::size_t step) {
     const auto &configObj = data["configuration"];
 
     Configuration config;
@@ -85,7 +80,7 @@ Board createBoard(const nlohmann::json &data, std::size_t step) {
     config.maxRegenCellKore = configObj["maxRegenCellKore"];
     config.randomSeed = configObj["randomSeed"];
 
-    Board board(config);
+    Board board(GameContext::create(config));
 
     const auto &observation = data["steps"][step][0]["observation"];
 
@@ -93,8 +88,8 @@ Board createBoard(const nlohmann::json &data, std::size_t step) {
     board.meIndex = 0;
     board.remainingOverageTime = observation["remainingOverageTime"];
 
-    for (int i = 0, iMax = config.size * config.size; i < iMax; i++) {
-        board.cells.at(i).kore = observation["kore"][i];
+    for (int i = 0, iMax = board.config().size * board.config().size; i < iMax; i++) {
+        board.cells.kore(i) = observation["kore"][i];
     }
 
     for (std::size_t i = 0; i < observation["players"].size(); i++) {
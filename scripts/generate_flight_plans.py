@@ -1,4 +1,6 @@
 import itertools
+import re
+import struct
 from argparse import ArgumentParser
 from collections import defaultdict
 from copy import deepcopy
@@ -175,6 +177,13 @@ def plan_to_string(plan: List[Part]) -> str:
 
     return string
 
+def get_ordered_plans(plans_by_offset: Dict[Tuple[int, int], List[Tuple[int, str]]], dx: int, dy: int) -> List[Tuple[int, List[str]]]:
+    plans = plans_by_offset[(dx, dy)]
+    steps_options = sorted(set(steps for steps, _ in plans))
+
+    return [(steps_option, sorted([plan for steps, plan in plans if steps == steps_option], key=lambda plan: (len(plan), plan)))
+            for steps_option in steps_options]
+
 def write_plans(plans_by_offset: Dict[Tuple[int, int], List[Tuple[int, str]]], path: Path) -> None:
     if not path.parent.is_dir():
         path.parent.mkdir(parents=True)
@@ -187,18 +196,14 @@ def write_plans(plans_by_offset: Dict[Tuple[int, int], List[Tuple[int, str]]], p
                 if (dx, dy) not in plans_by_offset:
                     continue
 
-                plans = plans_by_offset[(dx, dy)]
-
-                steps_options = sorted(set(steps for steps, _ in plans))
-                unique_plans = len(set(plan for _, plan in plans))
+                ordered_plans = get_ordered_plans(plans_by_offset, dx, dy)
+                unique_plans = len(set(plan for _, plan in plans_by_offset[(dx, dy)]))
 
-                file.write(f"{dx} {dy} {len(steps_options)} {unique_plans}\n")
+                file.write(f"{dx} {dy} {len(ordered_plans)} {unique_plans}\n")
 
                 plans_seen = set()
 
-                for steps_option in steps_options:
-                    sorted_plans = sorted([plan for steps, plan in plans if steps == steps_option], key=lambda plan: (len(plan), plan))
-
+                for steps_option, sorted_plans in ordered_plans:
                     file.write(f"{steps_option} {len(sorted_plans)}\n")
                     for plan in sorted_plans:
                         is_first = plan not in plans_seen
@@ -208,9 +213,112 @@ def write_plans(plans_by_offset: Dict[Tuple[int, int], List[Tuple[int, str]]], p
 
     print(f"Successfully generated {path.resolve().relative_to(Path.cwd())}")
 
+def read_plans(path: Path) -> Dict[Tuple[int, int], List[Tuple[int, str]]]:
+    tokens = path.read_text(encoding="utf-8").split()
+    plans_by_offset = defaultdict(list)
+
+    position = 1
+    for _ in range(int(tokens[0])):
+        dx, dy, steps_options = int(tokens[position]), int(tokens[position + 1]), int(tokens[position + 2])
+        position += 4
+
+        for _ in range(steps_options):
+            steps, plan_count = int(tokens[position]), int(tokens[position + 1])
+            position += 2
+
+            for _ in range(plan_count):
+                plans_by_offset[(dx, dy)].append((steps, tokens[position + 1]))
+                position += 2
+
+    return plans_by_offset
+
+def encode_plan(plan: str) -> List[int]:
+    # Mirrors FlightPlanPart::encode() in agents/v*/core/FlightPlan.cpp
+    parts = []
+
+    for token in re.findall(r"[NESW]|C|\d+", plan):
+        if token in "NESW":
+            parts.append(PartType.TURN.value << 6 | "NESW".index(token))
+        elif token == "C":
+            parts.append(PartType.CONVERT.value << 6)
+        else:
+            parts.append(PartType.MOVE.value << 6 | int(token))
+
+    return parts
+
+def write_binary_plans(plans_by_offset: Dict[Tuple[int, int], List[Tuple[int, str]]], path: Path, board_size: int = 21) -> None:
+    # Mirrors the layout documented in agents/v*/strategy/FlightPlanTable.h
+    if not path.parent.is_dir():
+        path.parent.mkdir(parents=True)
+
+    cell_count = board_size * board_size
+    steps_count = max((steps + 1 for plans in plans_by_offset.values() for steps, _ in plans), default=0)
+
+    plan_ids = {}
+    unique_plans_by_index = [[] for _ in range(cell_count)]
+    plans_by_index_by_steps = [{} for _ in range(cell_count)]
+
+    for dx in range(board_size):
+        for dy in range(board_size):
+            if (dx, dy) not in plans_by_offset:
+                continue
+
+            index = dy * board_size + dx
+            plans_seen = set()
+
+            for steps_option, sorted_plans in get_ordered_plans(plans_by_offset, dx, dy):
+                steps_plans = plans_by_index_by_steps[index].setdefault(steps_option, [])
+
+                for plan in sorted_plans:
+                    plan_id = plan_ids.setdefault(plan, len(plan_ids))
+
+                    if plan not in plans_seen:
+                        plans_seen.add(plan)
+                        unique_plans_by_index[index].append(plan_id)
+
+                    steps_plans.append(plan_id)
+
+    plan_ids_by_value = list(plan_ids)
+
+    for unique_plans in unique_plans_by_index:
+        unique_plans.sort(key=lambda plan_id: len(plan_ids_by_value[plan_id]))
+
+    references = []
+    unique_offsets = [0]
+    steps_offsets = [0]
+
+    for unique_plans in unique_plans_by_index:
+        references.extend(unique_plans)
+        unique_offsets.append(len(references))
+
+    for plans_by_steps in plans_by_index_by_steps:
+        for steps in range(steps_count):
+            references.extend(plans_by_steps.get(steps, []))
+            steps_offsets.append(len(references))
+
+    part_offsets = [0]
+    parts = []
+
+    for plan in plan_ids:
+        parts.extend(encode_plan(plan))
+        part_offsets.append(len(parts))
+
+    plan_bytes = bytes([len(plan) for plan in plan_ids] + parts)
+    plan_bytes += b"\0" * (-len(plan_bytes) % 4)
+
+    values = [0x4250464b, 3, board_size, steps_count, len(plan_ids), len(references), len(parts),
+              *unique_offsets, *steps_offsets, *references, *part_offsets]
+
+    with path.open("wb+") as file:
+        file.write(struct.pack(f"<{len(values)}I", *values))
+        file.write(plan_bytes)
+
+    print(f"Successfully generated {path.resolve().relative_to(Path.cwd())}")
+
 def main() -> None:
     parser = ArgumentParser(description="Generate possible flight plans.")
     parser.add_argument("agent", type=str, help="name of the agent to store the plans in, relative to <build directory>/agents")
+    parser.add_argument("--from-text", action="store_true", help="only convert the agent's existing text plan files to the binary format")
 
     args = parser.parse_args()
 
@@ -218,6 +326,16 @@ def main() -> None:
     if not (agent_directory / "main.py").is_file():
         raise ValueError(f"Agent '{args.agent}' does not exist")
 
+    data_directory = agent_directory / "data"
+
+    if args.from_text:
+        for name in ["target-plans", "convert-plans"]:
+            text_file = data_directory / f"{name}.txt"
+            if text_file.is_file():
+                write_binary_plans(read_plans(text_file), data_directory / f"{name}.bin")
+
+        return
+
     available_parts = [
         Part.turn(Direction.NORTH),
         Part.turn(Direction.EAST),
@@ -272,10 +390,11 @@ def main() -> None:
 
         print(f"Successfully gathered flight plans of size {i}")
 
-    data_directory = agent_directory / "data"
-
     write_plans(target_plans, data_directory / "target-plans.txt")
     write_plans(convert_plans, data_directory / "convert-plans.txt")
 
+    write_binary_plans(target_plans, data_directory / "target-plans.bin")
+    write_binary_plans(convert_plans, data_directory / "convert-plans.bin")
+
 if __name__ == "__main__":
     main()